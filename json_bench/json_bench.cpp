@@ -0,0 +1,568 @@
+//          Copyright John W. Wilkinson 2007 - 2009.
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+// json spirit version 4.02
+
+// reports the throughput of the json spirit functions on generated documents,
+// json_bench_spirit_grammer is the same program built with JSON_SPIRIT_USE_SPIRIT_GRAMMER
+// defined, compare the two to see the gain from the hand-written parser
+
+#include "json_spirit.h"
+#include "json_spirit_reader_template.h"
+#include "json_spirit_cursor.h"
+#include "json_spirit_structural_index.h"
+
+#include <algorithm>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#if !defined( BOOST_NO_CXX11_HDR_THREAD ) && \
+    ( !defined( JSON_SPIRIT_USE_SPIRIT_GRAMMER ) || defined( BOOST_SPIRIT_THREADSAFE ) )
+    #define JSON_SPIRIT_BENCH_THREADS
+    #include <thread>
+    #include <vector>
+#endif
+
+using namespace std;
+using namespace json_spirit;
+
+namespace
+{
+    // an array of records, each with a mixture of value types
+
+    string make_records( int nb_records )
+    {
+        ostringstream os;
+
+        os << "[\n";
+
+        for( int i = 0; i < nb_records; ++i )
+        {
+            os << "    {\n"
+                  "        \"id\" : " << i << ",\n"
+                  "        \"name\" : \"record " << i << "\",\n"
+                  "        \"description\" : \"a short piece of text with a \\\"quote\\\" and a \\\\ backslash\",\n"
+                  "        \"price\" : " << i << ".25,\n"
+                  "        \"ratio\" : -" << i << ".5e-3,\n"
+                  "        \"active\" : " << ( i % 2 ? "true" : "false" ) << ",\n"
+                  "        \"parent\" : null,\n"
+                  "        \"tags\" : [ \"red\", \"green\", \"blue\" ],\n"
+                  "        \"position\" : [ " << i << ", " << i + 1 << ", " << i + 2 << " ]\n"
+                  "    }" << ( i + 1 < nb_records ? "," : "" ) << "\n";
+        }
+
+        os << "]\n";
+
+        return os.str();
+    }
+
+    // an array of records that are mostly long strings, eg. descriptions and fragments of HTML
+
+    string make_text_records( int nb_records )
+    {
+        const string sentence( "The quick brown fox jumps over the lazy dog, again and again. " );
+
+        string description;
+
+        for( int i = 0; i < 12; ++i ) description += sentence;
+
+        ostringstream os;
+
+        os << "[\n";
+
+        for( int i = 0; i < nb_records; ++i )
+        {
+            os << "    {\n"
+                  "        \"id\" : " << i << ",\n"
+                  "        \"description\" : \"" << description << "\",\n"
+                  "        \"html\" : \"<div class=\\\"item\\\">\\n  <p>" << description << "</p>\\n</div>\"\n"
+                  "    }" << ( i + 1 < nb_records ? "," : "" ) << "\n";
+        }
+
+        os << "]\n";
+
+        return os.str();
+    }
+
+    // an array of numbers, most of them reals with many significant digits
+
+    string make_numbers( int nb_numbers )
+    {
+        ostringstream os;
+
+        os.precision( 17 );
+
+        os << "[";
+
+        for( int i = 0; i < nb_numbers; ++i )
+        {
+            if( i != 0 ) os << ",";
+
+            switch( i % 4 )
+            {
+                case 0:  os << i * 7919;               break;
+                case 1:  os << 1.0 / ( i + 1 );        break;
+                case 2:  os << -i * 3.14159e-5;        break;
+                default: os << ( i + 0.5 ) * 1.0e100;  break;
+            }
+        }
+
+        os << "]";
+
+        return os.str();
+    }
+
+    // the same records with one on each line, as in a log
+
+    string make_record_lines( int nb_records )
+    {
+        Value records;
+
+        read( make_records( nb_records ), records );
+
+        string result;
+
+        const Array& array = records.get_array();
+
+        for( Array::const_iterator i = array.begin(); i != array.end(); ++i )
+        {
+            result += write( *i ) + '\n';
+        }
+
+        return result;
+    }
+
+    // objects nested one in another, each with a few members beside the next
+
+    string make_nested( int depth )
+    {
+        ostringstream os;
+
+        for( int i = 0; i < depth; ++i )
+        {
+            os << "{ \"level\" : " << i << ", \"name\" : \"level " << i << "\", \"tags\" : [ \"red\", \"green\" ], \"child\" : ";
+        }
+
+        os << "null";
+
+        for( int i = 0; i < depth; ++i ) os << " }";
+
+        return os.str();
+    }
+
+    double elapsed_secs( clock_t start )
+    {
+        return static_cast< double >( clock() - start ) / CLOCKS_PER_SEC;
+    }
+
+    // clock() adds up the time of all threads, so benchmarks using several threads measure wall time
+
+    double elapsed_wall_secs( const boost::posix_time::ptime& start )
+    {
+        return static_cast< double >( ( boost::posix_time::microsec_clock::universal_time() - start ).total_microseconds() ) / 1e6;
+    }
+
+    void report( const char* name, string::size_type nb_bytes, int nb_iterations, double secs )
+    {
+        const double mb = static_cast< double >( nb_bytes ) * nb_iterations / ( 1024 * 1024 );
+
+        cout << name << ": " << mb / secs << " MB/s" << endl;
+    }
+
+    void bench_structural_index( const char* name, const string& s, int nb_iterations, 
+                                 internal_::Structural_index::Method method )
+    {
+        internal_::Structural_index index;
+
+        const clock_t start = clock();
+
+        for( int i = 0; i < nb_iterations; ++i )
+        {
+            if( !index.build( s.data(), s.data() + s.size(), method ) ) return;
+        }
+
+        report( name, s.size(), nb_iterations, elapsed_secs( start ) );
+    }
+
+    template< class Value_type >
+    void bench_read( const char* name, const string& s, int nb_iterations )
+    {
+        const clock_t start = clock();
+
+        for( int i = 0; i < nb_iterations; ++i )
+        {
+            Value_type value;
+
+            read( s, value );
+        }
+
+        report( name, s.size(), nb_iterations, elapsed_secs( start ) );
+    }
+
+    // reading from an iterator range, the default read() of a string should be as fast
+
+    template< class Value_type >
+    void bench_read_range( const char* name, const string& s, int nb_iterations )
+    {
+        const clock_t start = clock();
+
+        for( int i = 0; i < nb_iterations; ++i )
+        {
+            Value_type value;
+
+            string::const_iterator begin = s.begin();
+
+            read( begin, s.end(), value );
+        }
+
+        report( name, s.size(), nb_iterations, elapsed_secs( start ) );
+    }
+
+    void bench_read_from_stream( const char* name, const string& s, int nb_iterations )
+    {
+        const clock_t start = clock();
+
+        for( int i = 0; i < nb_iterations; ++i )
+        {
+            istringstream is( s );
+
+            Value value;
+
+            read( is, value );
+        }
+
+        report( name, s.size(), nb_iterations, elapsed_secs( start ) );
+    }
+
+    // counts the values of a document without building it
+
+    struct Value_counter
+    {
+        Value_counter() : nb_values_( 0 ) {}
+
+        void begin_obj()   { ++nb_values_; }
+        void end_obj()     {}
+        void begin_array() { ++nb_values_; }
+        void end_array()   {}
+
+        void new_name( const string& ) {}
+        void new_str ( const string& ) { ++nb_values_; }
+
+        void new_bool( bool )              { ++nb_values_; }
+        void new_null()                    { ++nb_values_; }
+        void new_int( boost::int64_t )     { ++nb_values_; }
+        void new_uint64( boost::uint64_t ) { ++nb_values_; }
+        void new_real( double )            { ++nb_values_; }
+
+        int nb_values_;
+    };
+
+    void bench_read_events( const char* name, const string& s, int nb_iterations )
+    {
+        const clock_t start = clock();
+
+        for( int i = 0; i < nb_iterations; ++i )
+        {
+            Value_counter counter;
+
+            read_events( s, counter );
+        }
+
+        report( name, s.size(), nb_iterations, elapsed_secs( start ) );
+    }
+
+    // reads the "id" and "price" of every record, skipping the rest
+
+    void bench_cursor( const char* name, const string& s, int nb_iterations )
+    {
+        const clock_t start = clock();
+
+        for( int i = 0; i < nb_iterations; ++i )
+        {
+            Cursor c( s );
+
+            double total = 0;
+            string key;
+
+            c.enter_array();
+
+            while( c.next_element() )
+            {
+                c.enter_object();
+
+                while( c.next_key( key ) )
+                {
+                    if( key == "id" || key == "price" ) total += c.get_real();
+                    else c.skip();
+                }
+            }
+        }
+
+        report( name, s.size(), nb_iterations, elapsed_secs( start ) );
+    }
+
+    template< class Value_type >
+    void bench_reader( const char* name, const string& s, int nb_iterations )
+    {
+        Reader< Value_type > reader;
+
+        const clock_t start = clock();
+
+        for( int i = 0; i < nb_iterations; ++i )
+        {
+            Value_type value;
+
+            reader.parse( s, value );
+        }
+
+        report( name, s.size(), nb_iterations, elapsed_secs( start ) );
+    }
+
+    template< class Value_type >
+    void count_line( int& nb_lines, size_t, Value_type& )
+    {
+        ++nb_lines;
+    }
+
+    template< class Value_type >
+    void bench_read_lines( const char* name, const string& s, int nb_iterations, unsigned int nb_threads )
+    {
+        const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+        for( int i = 0; i < nb_iterations; ++i )
+        {
+            int nb_lines = 0;
+
+            read_lines< Value_type >( s, boost::bind( &count_line< Value_type >, boost::ref( nb_lines ), _1, _2 ), nb_threads );
+        }
+
+        report( name, s.size(), nb_iterations, elapsed_wall_secs( start ) );
+    }
+
+    template< class Value_type >
+    void bench_read_in_parallel( const char* name, const string& s, int nb_iterations, unsigned int nb_threads )
+    {
+        const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+        for( int i = 0; i < nb_iterations; ++i )
+        {
+            Value_type value;
+
+            read_in_parallel( s, value, nb_threads );
+        }
+
+        report( name, s.size(), nb_iterations, elapsed_wall_secs( start ) );
+    }
+
+#ifdef JSON_SPIRIT_BENCH_THREADS
+
+    template< class Value_type >
+    void read_repeatedly( const string* s, int nb_iterations )
+    {
+        for( int i = 0; i < nb_iterations; ++i )
+        {
+            Value_type value;
+
+            read( *s, value );
+        }
+    }
+
+    // the combined throughput of a thread per core, each reading the document independently
+
+    template< class Value_type >
+    void bench_read_on_every_core( const char* name, const string& s, int nb_iterations )
+    {
+        const unsigned int nb_threads = ( std::max )( 1u, std::thread::hardware_concurrency() );
+
+        const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+        std::vector< std::thread > threads;
+
+        for( unsigned int i = 0; i < nb_threads; ++i )
+        {
+            threads.push_back( std::thread( read_repeatedly< Value_type >, &s, nb_iterations ) );
+        }
+
+        for( unsigned int i = 0; i < nb_threads; ++i )
+        {
+            threads[i].join();
+        }
+
+        report( name, s.size(), nb_iterations * static_cast< int >( nb_threads ), elapsed_wall_secs( start ) );
+    }
+
+#endif
+
+    template< class Value_type >
+    void bench_read_or_throw( const char* name, const string& s, int nb_iterations )
+    {
+        const clock_t start = clock();
+
+        for( int i = 0; i < nb_iterations; ++i )
+        {
+            Value_type value;
+
+            read_or_throw( s, value );
+        }
+
+        report( name, s.size(), nb_iterations, elapsed_secs( start ) );
+    }
+
+    template< class Value_type >
+    void bench_write( const char* name, const Value_type& value, int nb_iterations )
+    {
+        const string::size_type nb_bytes = write( value ).size();
+
+        const clock_t start = clock();
+
+        for( int i = 0; i < nb_iterations; ++i )
+        {
+            write( value );
+        }
+
+        report( name, nb_bytes, nb_iterations, elapsed_secs( start ) );
+    }
+
+    void bench_write_to_stream( const char* name, const Value& value, int nb_iterations )
+    {
+        const string::size_type nb_bytes = write( value ).size();
+
+        const clock_t start = clock();
+
+        for( int i = 0; i < nb_iterations; ++i )
+        {
+            ostringstream os;
+
+            write( value, os );
+        }
+
+        report( name, nb_bytes, nb_iterations, elapsed_secs( start ) );
+    }
+
+    // small documents that fail near their end, as sent by a misbehaving client
+
+    void report_docs( const char* name, int nb_iterations, double secs )
+    {
+        cout << name << ": " << nb_iterations / secs << " docs/s" << endl;
+    }
+
+    void bench_read_malformed( const char* name, const string& s, int nb_iterations )
+    {
+        const clock_t start = clock();
+
+        for( int i = 0; i < nb_iterations; ++i )
+        {
+            Value value;
+            Error_position error;
+
+            read( s, value, error );
+        }
+
+        report_docs( name, nb_iterations, elapsed_secs( start ) );
+    }
+
+    void bench_read_or_throw_malformed( const char* name, const string& s, int nb_iterations )
+    {
+        const clock_t start = clock();
+
+        for( int i = 0; i < nb_iterations; ++i )
+        {
+            try
+            {
+                Value value;
+
+                read_or_throw( s, value );
+            }
+            catch( const Error_position& )
+            {
+            }
+        }
+
+        report_docs( name, nb_iterations, elapsed_secs( start ) );
+    }
+}
+
+int main()
+{
+    const string records = make_records( 5000 );
+
+    cout << "document size " << records.size() << " bytes" << endl;
+
+    bench_structural_index( "structural index scalar", records, 200, internal_::Structural_index::scalar );
+    bench_structural_index( "structural index SSE2  ", records, 200, internal_::Structural_index::sse2 );
+    bench_structural_index( "structural index AVX2  ", records, 200, internal_::Structural_index::avx2 );
+
+    bench_read< Value  >( "read Value           ", records, 20 );
+    bench_read_range< Value >( "read Value from range", records, 20 );
+    bench_read< mValue >( "read mValue          ", records, 20 );
+    bench_read< hValue >( "read hValue          ", records, 20 );
+    bench_read< fValue >( "read fValue          ", records, 20 );
+    bench_read< cValue >( "read cValue          ", records, 20 );
+    bench_read< iValue >( "read iValue          ", records, 20 );
+    bench_read_or_throw< Value >( "read_or_throw Value  ", records, 20 );
+    bench_read_from_stream( "read Value from stream", records, 20 );
+#ifdef JSON_SPIRIT_BENCH_THREADS
+    bench_read_on_every_core< Value >( "read Value, all cores", records, 20 );
+#endif
+    bench_read_events( "read_events          ", records, 20 );
+    bench_cursor     ( "cursor, 2 fields     ", records, 20 );
+
+    const string text_records = make_text_records( 1000 );
+
+    bench_read< Value  >( "read text            ", text_records, 20 );
+    bench_read_range< Value >( "read text from range", text_records, 20 );
+    bench_read< vValue >( "read text vValue     ", text_records, 20 );
+
+    const string numbers = make_numbers( 200000 );
+
+    bench_read< Value >( "read numbers         ", numbers, 20 );
+
+    const string message = "{ \"id\" : 1234, \"method\" : \"update\", \"params\" : { \"name\" : \"record 1234\", "
+                           "\"price\" : 10.25, \"tags\" : [ \"red\", \"green\" ], \"position\" : [ 1, 2, 3 ] }, \"ack\" : true }";
+
+    cout << "message size " << message.size() << " bytes" << endl;
+
+    bench_read  < Value  >( "read message         ", message, 200000 );
+    bench_reader< Value  >( "Reader, message      ", message, 200000 );
+    bench_read  < mValue >( "read message mValue  ", message, 200000 );
+    bench_reader< mValue >( "Reader, message mValue", message, 200000 );
+
+    const string record_lines = make_record_lines( 5000 );
+
+    bench_read_lines< Value >( "read_lines, 1 thread ", record_lines, 20, 1 );
+    bench_read_lines< Value >( "read_lines, all cores", record_lines, 20, 0 );
+
+    const string many_records = make_records( 20000 );
+
+    bench_read_in_parallel< Value >( "read_in_parallel, 1 thread ", many_records, 5, 1 );
+    bench_read_in_parallel< Value >( "read_in_parallel, all cores", many_records, 5, 0 );
+
+    Value records_value;
+
+    read( records, records_value );
+
+    bench_write          ( "write Value          ", records_value, 20 );
+    bench_write_to_stream( "write Value to stream", records_value, 20 );
+
+    const string nested = make_nested( 500 );
+
+    Value  nested_value;
+    mValue nested_map_value;
+
+    read( nested, nested_value );
+    read( nested, nested_map_value );
+
+    bench_write( "write nested Value   ", nested_value, 20 );
+    bench_write( "write nested mValue  ", nested_map_value, 20 );
+
+    const string malformed = "{ \"id\" : 1, \"tags\" : [ \"red\", \"green\" }";
+
+    bench_read_malformed         ( "read malformed         ", malformed, 200000 );
+    bench_read_or_throw_malformed( "read_or_throw malformed", malformed, 200000 );
+
+    return 0;
+}
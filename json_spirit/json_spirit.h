@@ -11,6 +11,9 @@
 #endif
 
 #include "json_spirit_value.h"
+#include "json_spirit_compact_value.h"
+#include "json_spirit_hash_object.h"
+#include "json_spirit_flat_object.h"
 #include "json_spirit_reader.h"
 #include "json_spirit_writer.h"
 #include "json_spirit_utils.h"
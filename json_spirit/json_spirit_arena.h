@@ -0,0 +1,267 @@
+#ifndef JASON_SPIRIT_ARENA
+#define JASON_SPIRIT_ARENA
+
+//          Copyright John W. Wilkinson 2007 - 2009.
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+// json spirit version 4.02
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include <vector>
+#include <new>
+#include <cstddef>
+#include <boost/config.hpp>
+
+#ifndef BOOST_NO_CXX11_ALLOCATOR
+    #include <type_traits>
+#endif
+
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+    #define JSON_SPIRIT_THREAD_LOCAL thread_local
+#else
+    #define JSON_SPIRIT_THREAD_LOCAL  // without thread_local one current arena is shared by all threads
+#endif
+
+namespace json_spirit
+{
+    // A monotonic arena: memory is handed out from large blocks and is never freed individually,
+    // everything allocated from the arena is freed at once by release() or the destructor.
+    //
+    // Values using the "a" configs below allocate their strings, arrays and objects from the
+    // arena that is current, see Arena::Scope, when each container is created, eg.
+    //
+    //    Arena arena;
+    //    {
+    //        Arena::Scope scope( arena );
+    //        aValue value;
+    //        read( request, value );
+    //        handle( value );
+    //    }
+    //    arena.release();
+    //
+    // The values must be destroyed before the arena is released. A value copied outside the
+    // scope of the arena still refers to it, so copy into a Value or mValue to keep the result.
+    //
+    class Arena
+    {
+    public:
+
+        explicit Arena( std::size_t block_size = 64 * 1024 );
+        ~Arena();
+
+        void* allocate( std::size_t size );  // suitably aligned for any type
+        void release();
+
+        std::size_t bytes_allocated() const;  // since construction or the last release
+
+        // makes an arena the current one for this thread for the lifetime of the scope
+
+        class Scope
+        {
+        public:
+
+            explicit Scope( Arena& arena );
+            ~Scope();
+
+        private:
+
+            Scope( const Scope& );
+            Scope& operator=( const Scope& );
+
+            Arena* previous_;
+        };
+
+        static Arena* current();  // or null if there is no current arena
+
+    private:
+
+        Arena( const Arena& );
+        Arena& operator=( const Arena& );
+
+        static Arena*& current_ref();
+
+        const std::size_t block_size_;
+        std::vector< char* > blocks_;
+        char* next_;
+        char* end_;
+        std::size_t bytes_allocated_;
+    };
+
+    // A standard allocator that allocates from the arena that was current when it was constructed,
+    // or from the heap if there was none. Containers default construct their allocators, so
+    // every string, array and object created by a read inside an Arena::Scope uses the arena.
+    //
+    // Allocators of different arenas compare unequal. Containers swap and move assign their
+    // allocators along with their contents, so values read into different arenas can be 
+    // swapped and assigned, the result refers to whichever arena holds its contents.
+    //
+    template< class T >
+    class Arena_allocator
+    {
+    public:
+
+        typedef T              value_type;
+        typedef T*             pointer;
+        typedef const T*       const_pointer;
+        typedef T&             reference;
+        typedef const T&       const_reference;
+        typedef std::size_t    size_type;
+        typedef std::ptrdiff_t difference_type;
+
+#ifndef BOOST_NO_CXX11_ALLOCATOR
+        typedef std::true_type propagate_on_container_swap;
+        typedef std::true_type propagate_on_container_move_assignment;
+#endif
+
+        template< class U > struct rebind { typedef Arena_allocator< U > other; };
+
+        Arena_allocator()
+        :   arena_( Arena::current() )
+        {
+        }
+
+        template< class U >
+        Arena_allocator( const Arena_allocator< U >& other )
+        :   arena_( other.arena() )
+        {
+        }
+
+        T* allocate( size_type n, const void* = 0 )
+        {
+            if( arena_ != 0 ) return static_cast< T* >( arena_->allocate( n * sizeof( T ) ) );
+
+            return static_cast< T* >( ::operator new( n * sizeof( T ) ) );
+        }
+
+        void deallocate( T* p, size_type )
+        {
+            if( arena_ == 0 ) ::operator delete( p );
+        }
+
+        size_type max_size() const
+        {
+            return static_cast< size_type >( -1 ) / sizeof( T );
+        }
+
+#ifdef BOOST_NO_CXX11_ALLOCATOR
+        // C++11 containers construct elements themselves, which allows them to be moved into place
+
+        pointer       address( reference       r ) const { return &r; }
+        const_pointer address( const_reference r ) const { return &r; }
+
+        void construct( pointer p, const T& value ) { new( p ) T( value ); }
+        void destroy  ( pointer p )                 { p->~T(); }
+#endif
+
+        Arena* arena() const
+        {
+            return arena_;
+        }
+
+    private:
+
+        Arena* arena_;
+    };
+
+    template< class T, class U >
+    bool operator==( const Arena_allocator< T >& lhs, const Arena_allocator< U >& rhs )
+    {
+        return lhs.arena() == rhs.arena();
+    }
+
+    template< class T, class U >
+    bool operator!=( const Arena_allocator< T >& lhs, const Arena_allocator< U >& rhs )
+    {
+        return !( lhs == rhs );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // implementation
+
+    inline Arena::Arena( std::size_t block_size )
+    :   block_size_( block_size )
+    ,   next_( 0 )
+    ,   end_( 0 )
+    ,   bytes_allocated_( 0 )
+    {
+    }
+
+    inline Arena::~Arena()
+    {
+        release();
+    }
+
+    inline void* Arena::allocate( std::size_t size )
+    {
+        const std::size_t alignment = 2 * sizeof( void* );
+
+        size = ( size + alignment - 1 ) & ~( alignment - 1 );
+
+        if( static_cast< std::size_t >( end_ - next_ ) < size )
+        {
+            const std::size_t new_block_size = size > block_size_ ? size : block_size_;
+
+            blocks_.push_back( 0 );  // first, so that the new block cannot be leaked
+
+            next_ = static_cast< char* >( ::operator new( new_block_size ) );
+            end_  = next_ + new_block_size;
+
+            blocks_.back() = next_;
+        }
+
+        void* const result = next_;
+
+        next_ += size;
+        bytes_allocated_ += size;
+
+        return result;
+    }
+
+    inline void Arena::release()
+    {
+        for( std::vector< char* >::const_iterator i = blocks_.begin(); i != blocks_.end(); ++i )
+        {
+            ::operator delete( *i );
+        }
+
+        blocks_.clear();
+
+        next_ = 0;
+        end_  = 0;
+        bytes_allocated_ = 0;
+    }
+
+    inline std::size_t Arena::bytes_allocated() const
+    {
+        return bytes_allocated_;
+    }
+
+    inline Arena* Arena::current()
+    {
+        return current_ref();
+    }
+
+    inline Arena*& Arena::current_ref()
+    {
+        static JSON_SPIRIT_THREAD_LOCAL Arena* current = 0;
+
+        return current;
+    }
+
+    inline Arena::Scope::Scope( Arena& arena )
+    :   previous_( current_ref() )
+    {
+        current_ref() = &arena;
+    }
+
+    inline Arena::Scope::~Scope()
+    {
+        current_ref() = previous_;
+    }
+}
+
+#endif
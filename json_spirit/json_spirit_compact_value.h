@@ -0,0 +1,994 @@
+#ifndef JASON_SPIRIT_COMPACT_VALUE
+#define JASON_SPIRIT_COMPACT_VALUE
+
+//          Copyright John W. Wilkinson 2007 - 2009.
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+// json spirit version 4.02
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include "json_spirit_value.h"
+#include <new>
+#include <cstddef>
+#include <algorithm>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+namespace json_spirit
+{
+    // A vector that is a single pointer, to one allocation holding its size and capacity
+    // followed by its elements, or null until it has any capacity. The objects and arrays of
+    // compact values are these vectors, so that each costs one allocation and no more.
+    //
+    // The part of std::vector's interface that values are built and read with is provided.
+    // Iterators are pointers and, as with std::vector, growing the vector invalidates them.
+    //
+    template< class T >
+    class Compact_vector
+    {
+    public:
+
+        typedef T              value_type;
+        typedef T&             reference;
+        typedef const T&       const_reference;
+        typedef T*             pointer;
+        typedef const T*       const_pointer;
+        typedef T*             iterator;
+        typedef const T*       const_iterator;
+        typedef std::size_t    size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        Compact_vector();
+        Compact_vector( const Compact_vector& other );
+
+        template< class Iter >
+        Compact_vector( Iter first, Iter last );
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        Compact_vector( Compact_vector&& other ) BOOST_NOEXCEPT;  // leaves other empty
+
+        Compact_vector& operator=( Compact_vector&& other ) BOOST_NOEXCEPT;
+#endif
+
+        ~Compact_vector();
+
+        Compact_vector& operator=( const Compact_vector& other );
+
+        iterator       begin();
+        iterator       end();
+        const_iterator begin() const;
+        const_iterator end()   const;
+
+        size_type size()     const;
+        size_type capacity() const;
+        bool      empty()    const;
+
+        void reserve( size_type n );
+
+        reference       operator[]( size_type i );
+        const_reference operator[]( size_type i ) const;
+        reference       front();
+        const_reference front() const;
+        reference       back();
+        const_reference back() const;
+
+        void push_back( const T& value );
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        void push_back( T&& value );
+
+        template< class Arg >
+        void emplace_back( Arg&& arg );
+
+        template< class Arg_1, class Arg_2 >
+        void emplace_back( Arg_1&& arg_1, Arg_2&& arg_2 );
+#endif
+
+        void     pop_back();
+        iterator erase( iterator i );
+        iterator erase( iterator first, iterator last );
+        void     clear();
+
+        void swap( Compact_vector& other );
+
+        bool operator==( const Compact_vector& other ) const;
+        bool operator!=( const Compact_vector& other ) const;
+
+    private:
+
+        struct Header
+        {
+            size_type size_;
+            size_type capacity_;
+        };
+
+        static Header* allocate( size_type capacity );
+        static std::size_t elements_offset();
+
+        T* elements() const;
+
+        // an element is added by constructing it at back_slot(), then calling added_back(),
+        // when this is full the slot is in grown, which takes over the elements
+
+        T*   back_slot ( Compact_vector& grown );
+        void added_back( Compact_vector& grown );
+
+        void copy_elements_to( Compact_vector& other ) const;
+        void move_elements_to( Compact_vector& other );
+
+        Header* p_;
+    };
+
+    // A value with the same interface as Value_impl that takes 16 bytes rather than the size
+    // of a whole string plus a variant. Numbers and bools are held in the value itself, a string
+    // is owned through a pointer, and an object or array is a Compact_vector, which is itself
+    // one pointer. One tag byte records the type and whether an integer is a uint64, so that
+    // arrays of numbers are stored contiguously and an array of arrays or objects is an array
+    // of pointers.
+    //
+    // An object or array costs one allocation, for its members or elements. A string costs
+    // one for the String_type, and a second for its characters when they are too many for
+    // the string to hold in itself.
+    //
+    template< class Config >
+    class Compact_value_impl
+    {
+    public:
+
+        typedef Config Config_type;
+        typedef typename Config::String_type String_type;
+        typedef typename Config::Object_type Object;
+        typedef typename Config::Array_type Array;
+        typedef typename String_type::const_pointer Const_str_ptr;  // eg const char*
+
+        Compact_value_impl();  // creates null value
+        Compact_value_impl( Const_str_ptr      value );
+        Compact_value_impl( const String_type& value );
+        Compact_value_impl( const Object&      value );
+        Compact_value_impl( const Array&       value );
+        Compact_value_impl( bool               value );
+        Compact_value_impl( int                value );
+        Compact_value_impl( boost::int64_t     value );
+        Compact_value_impl( boost::uint64_t    value );
+        Compact_value_impl( double             value );
+
+        Compact_value_impl( const Compact_value_impl& other );
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        Compact_value_impl( String_type&& value );
+        Compact_value_impl( Object&&      value );
+        Compact_value_impl( Array&&       value );
+
+        Compact_value_impl( Compact_value_impl&& other ) BOOST_NOEXCEPT;  // leaves other null
+
+        Compact_value_impl& operator=( Compact_value_impl&& lhs ) BOOST_NOEXCEPT;
+#endif
+
+        ~Compact_value_impl();
+
+        bool operator==( const Compact_value_impl& lhs ) const;
+
+        Compact_value_impl& operator=( const Compact_value_impl& lhs );
+
+        Value_type type() const;
+
+        bool is_uint64() const;
+        bool is_null() const;
+
+        const String_type& get_str()    const;
+        const Object&      get_obj()    const;
+        const Array&       get_array()  const;
+        bool               get_bool()   const;
+        int                get_int()    const;
+        boost::int64_t     get_int64()  const;
+        boost::uint64_t    get_uint64() const;
+        double             get_real()   const;
+
+        Object& get_obj();
+        Array&  get_array();
+
+        template< typename T > T get_value() const;  // example usage: int    i = value.get_value< int >();
+                                                     // or             double d = value.get_value< double >();
+
+        static const Compact_value_impl null;
+
+    private:
+
+        // the tags of the first seven types match Value_type, an integer
+        // constructed from a uint64 is tagged separately
+        //
+        enum Tag{ obj_tag = obj_type, array_tag = array_type, str_tag = str_type, bool_tag = bool_type,
+                  int_tag = int_type, real_tag = real_type, null_tag = null_type, uint64_tag };
+
+        void swap( Compact_value_impl& other );
+        void take( Compact_value_impl& other );  // this must hold nothing that needs destroying
+
+        Object&       obj();
+        const Object& obj() const;
+        Array&        array();
+        const Array&  array() const;
+
+        union
+        {
+            String_type*   str_p_;
+            char           container_[ sizeof( void* ) ];  // the Object or Array, constructed in place
+            bool           bool_;
+            boost::int64_t int_;
+            double         real_;
+        };
+
+        unsigned char tag_;
+    };
+
+    // vector objects of compact values
+
+    template< class String >
+    struct Config_compact
+    {
+        typedef String String_type;
+        typedef Compact_value_impl< Config_compact > Value_type;
+        typedef Pair_impl < Config_compact > Pair_type;
+        typedef Compact_vector< Value_type > Array_type;
+        typedef Compact_vector< Pair_type > Object_type;
+
+        static Value_type& add( Object_type& obj, const String_type& name, const Value_type& value )
+        {
+            obj.push_back( Pair_type( name , value ) );
+
+            return obj.back().value_;
+        }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        static Value_type& add( Object_type& obj, String_type&& name, Value_type&& value )
+        {
+            obj.emplace_back( std::move( name ), std::move( value ) );
+
+            return obj.back().value_;
+        }
+#endif
+
+        static const String_type& get_name( const Pair_type& pair )
+        {
+            return pair.name_;
+        }
+
+        static const Value_type& get_value( const Pair_type& pair )
+        {
+            return pair.value_;
+        }
+    };
+
+    // typedefs for ASCII
+
+    typedef Config_compact< std::string > cConfig;
+
+    typedef cConfig::Value_type  cValue;
+    typedef cConfig::Pair_type   cPair;
+    typedef cConfig::Object_type cObject;
+    typedef cConfig::Array_type  cArray;
+
+    // typedefs for Unicode
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    typedef Config_compact< std::wstring > wcConfig;
+
+    typedef wcConfig::Value_type  wcValue;
+    typedef wcConfig::Pair_type   wcPair;
+    typedef wcConfig::Object_type wcObject;
+    typedef wcConfig::Array_type  wcArray;
+#endif
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // implementation
+
+    template< class T >
+    Compact_vector< T >::Compact_vector()
+    :   p_( 0 )
+    {
+    }
+
+    template< class T >
+    Compact_vector< T >::Compact_vector( const Compact_vector& other )
+    :   p_( 0 )
+    {
+        if( other.empty() ) return;
+
+        Compact_vector tmp;  // filled aside, so that a failure frees what was copied
+
+        tmp.p_ = allocate( other.size() );
+
+        other.copy_elements_to( tmp );
+
+        swap( tmp );
+    }
+
+    template< class T >
+    template< class Iter >
+    Compact_vector< T >::Compact_vector( Iter first, Iter last )
+    :   p_( 0 )
+    {
+        Compact_vector tmp;
+
+        for( ; first != last; ++first )
+        {
+            tmp.push_back( *first );
+        }
+
+        swap( tmp );
+    }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+
+    template< class T >
+    Compact_vector< T >::Compact_vector( Compact_vector&& other ) BOOST_NOEXCEPT
+    :   p_( other.p_ )
+    {
+        other.p_ = 0;
+    }
+
+    template< class T >
+    Compact_vector< T >& Compact_vector< T >::operator=( Compact_vector&& other ) BOOST_NOEXCEPT
+    {
+        Compact_vector tmp( std::move( other ) );
+
+        swap( tmp );
+
+        return *this;
+    }
+
+#endif
+
+    template< class T >
+    Compact_vector< T >::~Compact_vector()
+    {
+        clear();
+
+        ::operator delete( p_ );
+    }
+
+    template< class T >
+    Compact_vector< T >& Compact_vector< T >::operator=( const Compact_vector& other )
+    {
+        Compact_vector tmp( other );
+
+        swap( tmp );
+
+        return *this;
+    }
+
+    template< class T >
+    typename Compact_vector< T >::iterator Compact_vector< T >::begin()
+    {
+        return elements();
+    }
+
+    template< class T >
+    typename Compact_vector< T >::iterator Compact_vector< T >::end()
+    {
+        return elements() + size();
+    }
+
+    template< class T >
+    typename Compact_vector< T >::const_iterator Compact_vector< T >::begin() const
+    {
+        return elements();
+    }
+
+    template< class T >
+    typename Compact_vector< T >::const_iterator Compact_vector< T >::end() const
+    {
+        return elements() + size();
+    }
+
+    template< class T >
+    typename Compact_vector< T >::size_type Compact_vector< T >::size() const
+    {
+        return p_ != 0 ? p_->size_ : 0;
+    }
+
+    template< class T >
+    typename Compact_vector< T >::size_type Compact_vector< T >::capacity() const
+    {
+        return p_ != 0 ? p_->capacity_ : 0;
+    }
+
+    template< class T >
+    bool Compact_vector< T >::empty() const
+    {
+        return size() == 0;
+    }
+
+    template< class T >
+    void Compact_vector< T >::reserve( size_type n )
+    {
+        if( n <= capacity() ) return;
+
+        Compact_vector grown;
+
+        grown.p_ = allocate( n );
+
+        move_elements_to( grown );
+
+        swap( grown );
+    }
+
+    template< class T >
+    typename Compact_vector< T >::reference Compact_vector< T >::operator[]( size_type i )
+    {
+        assert( i < size() );
+
+        return elements()[i];
+    }
+
+    template< class T >
+    typename Compact_vector< T >::const_reference Compact_vector< T >::operator[]( size_type i ) const
+    {
+        assert( i < size() );
+
+        return elements()[i];
+    }
+
+    template< class T >
+    typename Compact_vector< T >::reference Compact_vector< T >::front()
+    {
+        return (*this)[ 0 ];
+    }
+
+    template< class T >
+    typename Compact_vector< T >::const_reference Compact_vector< T >::front() const
+    {
+        return (*this)[ 0 ];
+    }
+
+    template< class T >
+    typename Compact_vector< T >::reference Compact_vector< T >::back()
+    {
+        return (*this)[ size() - 1 ];
+    }
+
+    template< class T >
+    typename Compact_vector< T >::const_reference Compact_vector< T >::back() const
+    {
+        return (*this)[ size() - 1 ];
+    }
+
+    // each new element is constructed before the existing ones are moved, as its
+    // argument may be one of them
+
+    template< class T >
+    void Compact_vector< T >::push_back( const T& value )
+    {
+        Compact_vector grown;
+
+        new( back_slot( grown ) ) T( value );
+
+        added_back( grown );
+    }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+
+    template< class T >
+    void Compact_vector< T >::push_back( T&& value )
+    {
+        Compact_vector grown;
+
+        new( back_slot( grown ) ) T( std::move( value ) );
+
+        added_back( grown );
+    }
+
+    template< class T >
+    template< class Arg >
+    void Compact_vector< T >::emplace_back( Arg&& arg )
+    {
+        Compact_vector grown;
+
+        new( back_slot( grown ) ) T( std::forward< Arg >( arg ) );
+
+        added_back( grown );
+    }
+
+    template< class T >
+    template< class Arg_1, class Arg_2 >
+    void Compact_vector< T >::emplace_back( Arg_1&& arg_1, Arg_2&& arg_2 )
+    {
+        Compact_vector grown;
+
+        new( back_slot( grown ) ) T( std::forward< Arg_1 >( arg_1 ), std::forward< Arg_2 >( arg_2 ) );
+
+        added_back( grown );
+    }
+
+#endif
+
+    template< class T >
+    void Compact_vector< T >::pop_back()
+    {
+        back().~T();
+
+        --p_->size_;
+    }
+
+    template< class T >
+    typename Compact_vector< T >::iterator Compact_vector< T >::erase( iterator i )
+    {
+        return erase( i, i + 1 );
+    }
+
+    template< class T >
+    typename Compact_vector< T >::iterator Compact_vector< T >::erase( iterator first, iterator last )
+    {
+        if( first == last ) return first;
+
+        const size_type pos = first - begin();
+
+#ifdef BOOST_NO_CXX11_RVALUE_REFERENCES
+        const iterator new_end = std::copy( last, end(), first );
+#else
+        const iterator new_end = std::move( last, end(), first );
+#endif
+
+        while( end() != new_end ) pop_back();
+
+        return begin() + pos;
+    }
+
+    template< class T >
+    void Compact_vector< T >::clear()
+    {
+        while( !empty() ) pop_back();
+    }
+
+    template< class T >
+    void Compact_vector< T >::swap( Compact_vector& other )
+    {
+        std::swap( p_, other.p_ );
+    }
+
+    template< class T >
+    bool Compact_vector< T >::operator==( const Compact_vector& other ) const
+    {
+        return size() == other.size() && std::equal( begin(), end(), other.begin() );
+    }
+
+    template< class T >
+    bool Compact_vector< T >::operator!=( const Compact_vector& other ) const
+    {
+        return !( *this == other );
+    }
+
+    template< class T >
+    typename Compact_vector< T >::Header* Compact_vector< T >::allocate( size_type capacity )
+    {
+        Header header = { 0, capacity };
+
+        return new( ::operator new( elements_offset() + capacity * sizeof( T ) ) ) Header( header );
+    }
+
+    template< class T >
+    std::size_t Compact_vector< T >::elements_offset()
+    {
+        const std::size_t alignment = boost::alignment_of< T >::value;
+
+        return ( sizeof( Header ) + alignment - 1 ) / alignment * alignment;
+    }
+
+    template< class T >
+    T* Compact_vector< T >::elements() const
+    {
+        if( p_ == 0 ) return 0;
+
+        return reinterpret_cast< T* >( reinterpret_cast< char* >( p_ ) + elements_offset() );
+    }
+
+    template< class T >
+    T* Compact_vector< T >::back_slot( Compact_vector& grown )
+    {
+        if( size() < capacity() ) return end();
+
+        grown.p_ = allocate( capacity() == 0 ? 4 : 2 * capacity() );
+
+        return grown.elements() + size();
+    }
+
+    template< class T >
+    void Compact_vector< T >::added_back( Compact_vector& grown )
+    {
+        if( grown.p_ != 0 )
+        {
+            try
+            {
+                move_elements_to( grown );
+            }
+            catch( ... )
+            {
+                ( grown.elements() + size() )->~T();  // the new element, grown only destroys those it has counted
+                throw;
+            }
+
+            swap( grown );
+        }
+
+        ++p_->size_;
+    }
+
+    template< class T >
+    void Compact_vector< T >::copy_elements_to( Compact_vector& other ) const
+    {
+        assert( other.size() == 0 && other.capacity() >= size() );
+
+        for( const_iterator i = begin(); i != end(); ++i )
+        {
+            new( other.elements() + other.p_->size_ ) T( *i );
+
+            ++other.p_->size_;
+        }
+    }
+
+    // copies rather than moves when moving may throw, so that a failure leaves this unchanged
+
+    template< class T >
+    void Compact_vector< T >::move_elements_to( Compact_vector& other )
+    {
+#ifdef BOOST_NO_CXX11_RVALUE_REFERENCES
+        copy_elements_to( other );
+#else
+        assert( other.size() == 0 && other.capacity() >= size() );
+
+        for( iterator i = begin(); i != end(); ++i )
+        {
+            new( other.elements() + other.p_->size_ ) T( std::move_if_noexcept( *i ) );
+
+            ++other.p_->size_;
+        }
+#endif
+    }
+
+    template< class Config >
+    const Compact_value_impl< Config > Compact_value_impl< Config >::null;
+
+    template< class Config >
+    Compact_value_impl< Config >::Compact_value_impl()
+    :   int_( 0 )
+    ,   tag_( null_tag )
+    {
+    }
+
+    template< class Config >
+    Compact_value_impl< Config >::Compact_value_impl( const Const_str_ptr value )
+    :   str_p_( new String_type( value ) )
+    ,   tag_( str_tag )
+    {
+    }
+
+    template< class Config >
+    Compact_value_impl< Config >::Compact_value_impl( const String_type& value )
+    :   str_p_( new String_type( value ) )
+    ,   tag_( str_tag )
+    {
+    }
+
+    template< class Config >
+    Compact_value_impl< Config >::Compact_value_impl( const Object& value )
+    :   tag_( obj_tag )
+    {
+        new( container_ ) Object( value );
+    }
+
+    template< class Config >
+    Compact_value_impl< Config >::Compact_value_impl( const Array& value )
+    :   tag_( array_tag )
+    {
+        new( container_ ) Array( value );
+    }
+
+    template< class Config >
+    Compact_value_impl< Config >::Compact_value_impl( bool value )
+    :   bool_( value )
+    ,   tag_( bool_tag )
+    {
+    }
+
+    template< class Config >
+    Compact_value_impl< Config >::Compact_value_impl( int value )
+    :   int_( value )
+    ,   tag_( int_tag )
+    {
+    }
+
+    template< class Config >
+    Compact_value_impl< Config >::Compact_value_impl( boost::int64_t value )
+    :   int_( value )
+    ,   tag_( int_tag )
+    {
+    }
+
+    template< class Config >
+    Compact_value_impl< Config >::Compact_value_impl( boost::uint64_t value )
+    :   int_( static_cast< boost::int64_t >( value ) )
+    ,   tag_( uint64_tag )
+    {
+    }
+
+    template< class Config >
+    Compact_value_impl< Config >::Compact_value_impl( double value )
+    :   real_( value )
+    ,   tag_( real_tag )
+    {
+    }
+
+    template< class Config >
+    Compact_value_impl< Config >::Compact_value_impl( const Compact_value_impl< Config >& other )
+    :   tag_( other.tag_ )
+    {
+        switch( tag_ )
+        {
+            case str_tag:   str_p_ = new String_type( *other.str_p_ );  break;
+            case obj_tag:   new( container_ ) Object( other.obj() );   break;
+            case array_tag: new( container_ ) Array( other.array() );  break;
+            case bool_tag:  bool_  = other.bool_;                      break;
+            case real_tag:  real_  = other.real_;                      break;
+            case null_tag:                                             break;
+            default:        int_   = other.int_;                       break;
+        }
+    }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+
+    template< class Config >
+    Compact_value_impl< Config >::Compact_value_impl( String_type&& value )
+    :   str_p_( new String_type( std::move( value ) ) )
+    ,   tag_( str_tag )
+    {
+    }
+
+    template< class Config >
+    Compact_value_impl< Config >::Compact_value_impl( Object&& value )
+    :   tag_( obj_tag )
+    {
+        new( container_ ) Object( std::move( value ) );
+    }
+
+    template< class Config >
+    Compact_value_impl< Config >::Compact_value_impl( Array&& value )
+    :   tag_( array_tag )
+    {
+        new( container_ ) Array( std::move( value ) );
+    }
+
+    template< class Config >
+    Compact_value_impl< Config >::Compact_value_impl( Compact_value_impl< Config >&& other ) BOOST_NOEXCEPT
+    :   tag_( null_tag )
+    {
+        take( other );
+    }
+
+    template< class Config >
+    Compact_value_impl< Config >& Compact_value_impl< Config >::operator=( Compact_value_impl&& lhs ) BOOST_NOEXCEPT
+    {
+        Compact_value_impl tmp( std::move( lhs ) );
+
+        swap( tmp );
+
+        return *this;
+    }
+
+#endif
+
+    template< class Config >
+    Compact_value_impl< Config >::~Compact_value_impl()
+    {
+        BOOST_STATIC_ASSERT( sizeof( Object ) <= sizeof( container_ ) && sizeof( Array ) <= sizeof( container_ ) );
+
+        switch( tag_ )
+        {
+            case str_tag:   delete str_p_;    break;
+            case obj_tag:   obj().~Object();  break;
+            case array_tag: array().~Array(); break;
+            default: break;
+        }
+    }
+
+    template< class Config >
+    Compact_value_impl< Config >& Compact_value_impl< Config >::operator=( const Compact_value_impl& lhs )
+    {
+        Compact_value_impl tmp( lhs );
+
+        swap( tmp );
+
+        return *this;
+    }
+
+    template< class Config >
+    void Compact_value_impl< Config >::swap( Compact_value_impl& other )
+    {
+        Compact_value_impl tmp;
+
+        tmp.take( other );
+        other.take( *this );
+        take( tmp );
+    }
+
+    // moves the member in use from other to this, leaving other null, an object
+    // or array is handed over by swapping, which cannot throw
+
+    template< class Config >
+    void Compact_value_impl< Config >::take( Compact_value_impl& other )
+    {
+        switch( other.tag_ )
+        {
+            case str_tag:   str_p_ = other.str_p_; break;
+            case obj_tag:   new( container_ ) Object(); obj().swap( other.obj() );     other.obj().~Object(); break;
+            case array_tag: new( container_ ) Array();  array().swap( other.array() ); other.array().~Array(); break;
+            case bool_tag:  bool_  = other.bool_;  break;
+            case real_tag:  real_  = other.real_;  break;
+            case null_tag:                         break;
+            default:        int_   = other.int_;   break;
+        }
+
+        tag_ = other.tag_;
+
+        other.tag_ = null_tag;
+    }
+
+    template< class Config >
+    typename Compact_value_impl< Config >::Object& Compact_value_impl< Config >::obj()
+    {
+        return *reinterpret_cast< Object* >( container_ );
+    }
+
+    template< class Config >
+    const typename Compact_value_impl< Config >::Object& Compact_value_impl< Config >::obj() const
+    {
+        return *reinterpret_cast< const Object* >( container_ );
+    }
+
+    template< class Config >
+    typename Compact_value_impl< Config >::Array& Compact_value_impl< Config >::array()
+    {
+        return *reinterpret_cast< Array* >( container_ );
+    }
+
+    template< class Config >
+    const typename Compact_value_impl< Config >::Array& Compact_value_impl< Config >::array() const
+    {
+        return *reinterpret_cast< const Array* >( container_ );
+    }
+
+    template< class Config >
+    bool Compact_value_impl< Config >::operator==( const Compact_value_impl& lhs ) const
+    {
+        if( this == &lhs ) return true;
+
+        if( type() != lhs.type() ) return false;
+
+        switch( tag_ )
+        {
+            case str_tag:   return *str_p_ == *lhs.str_p_;
+            case obj_tag:   return obj()   == lhs.obj();
+            case array_tag: return array() == lhs.array();
+            case bool_tag:  return bool_ == lhs.bool_;
+            case real_tag:  return real_ == lhs.real_;
+            case null_tag:  return true;
+            default:        return int_ == lhs.int_;
+        }
+    }
+
+    template< class Config >
+    Value_type Compact_value_impl< Config >::type() const
+    {
+        return tag_ == uint64_tag ? int_type : static_cast< Value_type >( tag_ );
+    }
+
+    template< class Config >
+    bool Compact_value_impl< Config >::is_uint64() const
+    {
+        return tag_ == uint64_tag;
+    }
+
+    template< class Config >
+    bool Compact_value_impl< Config >::is_null() const
+    {
+        return type() == null_type;
+    }
+
+    template< class Config >
+    const typename Compact_value_impl< Config >::String_type& Compact_value_impl< Config >::get_str() const
+    {
+        assert( type() == str_type );
+
+        return *str_p_;
+    }
+
+    template< class Config >
+    const typename Compact_value_impl< Config >::Object& Compact_value_impl< Config >::get_obj() const
+    {
+        assert( type() == obj_type );
+
+        return obj();
+    }
+
+    template< class Config >
+    const typename Compact_value_impl< Config >::Array& Compact_value_impl< Config >::get_array() const
+    {
+        assert( type() == array_type );
+
+        return array();
+    }
+
+    template< class Config >
+    bool Compact_value_impl< Config >::get_bool() const
+    {
+        assert( type() == bool_type );
+
+        return bool_;
+    }
+
+    template< class Config >
+    int Compact_value_impl< Config >::get_int() const
+    {
+        assert( type() == int_type );
+
+        return static_cast< int >( get_int64() );
+    }
+
+    template< class Config >
+    boost::int64_t Compact_value_impl< Config >::get_int64() const
+    {
+        assert( type() == int_type );
+
+        return int_;
+    }
+
+    template< class Config >
+    boost::uint64_t Compact_value_impl< Config >::get_uint64() const
+    {
+        assert( type() == int_type );
+
+        return static_cast< boost::uint64_t >( get_int64() );
+    }
+
+    template< class Config >
+    double Compact_value_impl< Config >::get_real() const
+    {
+        if( type() == int_type )
+        {
+            return is_uint64() ? static_cast< double >( get_uint64() )
+                               : static_cast< double >( get_int64() );
+        }
+
+        assert( type() == real_type );
+
+        return real_;
+    }
+
+    template< class Config >
+    typename Compact_value_impl< Config >::Object& Compact_value_impl< Config >::get_obj()
+    {
+        assert( type() == obj_type );
+
+        return obj();
+    }
+
+    template< class Config >
+    typename Compact_value_impl< Config >::Array& Compact_value_impl< Config >::get_array()
+    {
+        assert( type() == array_type );
+
+        return array();
+    }
+
+    template< class Config >
+    template< typename T >
+    T Compact_value_impl< Config >::get_value() const
+    {
+        return internal_::get_value( *this, internal_::Type_to_type< T >() );
+    }
+}
+
+#endif
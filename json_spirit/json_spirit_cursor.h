@@ -0,0 +1,466 @@
+#ifndef JASON_SPIRIT_CURSOR
+#define JASON_SPIRIT_CURSOR
+
+//          Copyright John W. Wilkinson 2007 - 2009.
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+// json spirit version 4.02
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include "json_spirit_reader_template.h"
+
+#include <string>
+#include <boost/cstdint.hpp>
+
+namespace json_spirit
+{
+    // A cursor walks a document a value at a time, decoding only the values asked for, eg.
+    //
+    //    Cursor c( text );
+    //    c.enter_object();
+    //    std::string key;
+    //    while( c.next_key( key ) )
+    //    {
+    //        if     ( key == "id"   ) id   = c.get_int();
+    //        else if( key == "name" ) name = c.get_str();
+    //        else c.skip();
+    //    }
+    //
+    // Every value must be read, entered or skipped before moving on to the next key or element.
+    // Skipping an object or array only matches up its brackets, so errors inside it are not found.
+    // The cursor refers to the text, which must outlive it. Errors are thrown as Error_positions.
+    //
+    template< class String_type >
+    class Basic_cursor
+    {
+    public:
+
+        typedef typename String_type::value_type Char_type;
+        typedef typename String_type::const_iterator Iter_type;
+
+        explicit Basic_cursor( const String_type& text );
+        Basic_cursor( Iter_type begin, Iter_type end );
+
+#if !defined( BOOST_NO_CXX11_RVALUE_REFERENCES ) && !defined( BOOST_NO_CXX11_DELETED_FUNCTIONS )
+        explicit Basic_cursor( String_type&& text ) = delete;  // the text would be destroyed while still in use
+#endif
+
+        json_spirit::Value_type type();  // of the next value, numbers with a fraction or exponent are real_type
+
+        void enter_object();
+        bool next_key( String_type& key );  // returns false, having left the object, after the last member
+        void enter_array();
+        bool next_element();                // returns false, having left the array, after the last element
+
+        void skip();
+
+        String_type     get_str();
+        bool            get_bool();
+        int             get_int();
+        boost::int64_t  get_int64();
+        boost::uint64_t get_uint64();
+        double          get_real();  // also accepts integers
+        void            get_null();
+
+        template< class Value_type >
+        void get_value( Value_type& value );  // reads the next value in full
+
+        Iter_type posn() const;  // the first character not yet read
+
+    private:
+
+        // the result of parsing a string, number or literal
+
+        struct Scalar_actions
+        {
+            Scalar_actions() : type_( null_type ), bool_( false ) {}
+
+            void begin_obj  ( Char_type ) {}
+            void end_obj    ( Char_type ) {}
+            void begin_array( Char_type ) {}
+            void end_array  ( Char_type ) {}
+
+            void new_name( Iter_type, Iter_type ) {}
+
+            void new_str( Iter_type begin, Iter_type end )
+            {
+                type_ = str_type;
+                str_  = internal_::get_str< String_type >( begin, end );
+            }
+
+            void new_true ( Iter_type, Iter_type ) { type_ = bool_type; bool_ = true;  }
+            void new_false( Iter_type, Iter_type ) { type_ = bool_type; bool_ = false; }
+            void new_null ( Iter_type, Iter_type ) { type_ = null_type; }
+
+            void new_number( const internal_::Number& number )
+            {
+                type_   = number.type_ == internal_::Number::real ? real_type : int_type;
+                number_ = number;
+            }
+
+            json_spirit::Value_type type_;
+            String_type str_;
+            bool bool_;
+            internal_::Number number_;
+        };
+
+        void skip_spaces();
+        bool is_next( char c ) const;
+        void expect( char c, const char* reason );
+        void read_scalar( Scalar_actions& scalar, json_spirit::Value_type type, const char* reason );
+        const internal_::Number& read_number( bool integer );
+        void skip_str();
+        void skip_compound();
+
+        void throw_error( Iter_type posn, const char* reason ) const;
+
+        const Iter_type begin_;
+        const Iter_type end_;
+        Iter_type i_;
+        bool first_;  // true if nothing has been read since the last '{' or '['
+        Scalar_actions scalar_;
+    };
+
+    typedef Basic_cursor< std::string > Cursor;
+
+#ifndef BOOST_NO_STD_WSTRING
+    typedef Basic_cursor< std::wstring > wCursor;
+#endif
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // implementation
+
+    template< class String_type >
+    Basic_cursor< String_type >::Basic_cursor( const String_type& text )
+    :   begin_( text.begin() )
+    ,   end_( text.end() )
+    ,   i_( text.begin() )
+    ,   first_( true )
+    {
+    }
+
+    template< class String_type >
+    Basic_cursor< String_type >::Basic_cursor( Iter_type begin, Iter_type end )
+    :   begin_( begin )
+    ,   end_( end )
+    ,   i_( begin )
+    ,   first_( true )
+    {
+    }
+
+    template< class String_type >
+    json_spirit::Value_type Basic_cursor< String_type >::type()
+    {
+        skip_spaces();
+
+        if( i_ == end_ ) throw_error( i_, "not a value" );
+
+        switch( *i_ )
+        {
+            case '{': return obj_type;
+            case '[': return array_type;
+            case '"': return str_type;
+            case 't': case 'f': return bool_type;
+            case 'n': return null_type;
+        }
+
+        internal_::Number number;
+
+        internal_::scan_number( i_, end_, number );
+
+        if( number.type_ == internal_::Number::none ) throw_error( i_, "not a value" );
+
+        return number.type_ == internal_::Number::real ? real_type : int_type;
+    }
+
+    template< class String_type >
+    void Basic_cursor< String_type >::enter_object()
+    {
+        skip_spaces();
+
+        expect( '{', "not an object" );
+
+        first_ = true;
+    }
+
+    template< class String_type >
+    bool Basic_cursor< String_type >::next_key( String_type& key )
+    {
+        skip_spaces();
+
+        if( is_next( '}' ) )
+        {
+            ++i_;
+            first_ = false;
+            return false;
+        }
+
+        if( !first_ ) expect( ',', "not an object" );
+
+        skip_spaces();
+
+        if( !is_next( '"' ) ) throw_error( i_, "not an object" );
+
+        read_scalar( scalar_, str_type, "not an object" );
+
+        key.swap( scalar_.str_ );
+
+        skip_spaces();
+
+        expect( ':', "no colon in pair" );
+
+        first_ = false;
+
+        return true;
+    }
+
+    template< class String_type >
+    void Basic_cursor< String_type >::enter_array()
+    {
+        skip_spaces();
+
+        expect( '[', "not an array" );
+
+        first_ = true;
+    }
+
+    template< class String_type >
+    bool Basic_cursor< String_type >::next_element()
+    {
+        skip_spaces();
+
+        if( is_next( ']' ) )
+        {
+            ++i_;
+            first_ = false;
+            return false;
+        }
+
+        if( !first_ ) expect( ',', "not an array" );
+
+        first_ = false;
+
+        return true;
+    }
+
+    template< class String_type >
+    void Basic_cursor< String_type >::skip()
+    {
+        const json_spirit::Value_type next_type = type();
+
+        switch( next_type )
+        {
+            case obj_type:
+            case array_type: skip_compound(); break;
+            case str_type:   skip_str();      break;
+            case int_type:
+            case real_type:  i_ = internal_::scan_number( i_, end_, scalar_.number_ ); break;
+            default:         read_scalar( scalar_, next_type, "not a value" );
+        }
+    }
+
+    template< class String_type >
+    String_type Basic_cursor< String_type >::get_str()
+    {
+        String_type result;
+
+        read_scalar( scalar_, str_type, "not a string" );
+
+        result.swap( scalar_.str_ );
+
+        return result;
+    }
+
+    template< class String_type >
+    bool Basic_cursor< String_type >::get_bool()
+    {
+        read_scalar( scalar_, bool_type, "not a bool" );
+
+        return scalar_.bool_;
+    }
+
+    template< class String_type >
+    int Basic_cursor< String_type >::get_int()
+    {
+        return static_cast< int >( get_int64() );
+    }
+
+    template< class String_type >
+    boost::int64_t Basic_cursor< String_type >::get_int64()
+    {
+        const internal_::Number& number = read_number( true );
+
+        if( number.type_ == internal_::Number::uint64 ) return static_cast< boost::int64_t >( number.uint64_ );
+
+        return number.int64_;
+    }
+
+    template< class String_type >
+    boost::uint64_t Basic_cursor< String_type >::get_uint64()
+    {
+        const internal_::Number& number = read_number( true );
+
+        if( number.type_ == internal_::Number::uint64 ) return number.uint64_;
+
+        return static_cast< boost::uint64_t >( number.int64_ );
+    }
+
+    template< class String_type >
+    double Basic_cursor< String_type >::get_real()
+    {
+        const internal_::Number& number = read_number( false );
+
+        switch( number.type_ )
+        {
+            case internal_::Number::int64:  return static_cast< double >( number.int64_ );
+            case internal_::Number::uint64: return static_cast< double >( number.uint64_ );
+            default:                        return number.real_;
+        }
+    }
+
+    template< class String_type >
+    void Basic_cursor< String_type >::get_null()
+    {
+        read_scalar( scalar_, null_type, "not null" );
+    }
+
+    template< class String_type >
+    template< class Value_type >
+    void Basic_cursor< String_type >::get_value( Value_type& value )
+    {
+        typedef internal_::Semantic_actions< Value_type, Iter_type > Actions_type;
+
+        Actions_type actions( value );
+
+        internal_::Json_parser< Actions_type, Iter_type > parser( actions, i_, end_ );
+
+        if( !parser.parse() ) throw_error( parser.posn(), parser.error_reason() );
+
+        i_ = parser.posn();
+    }
+
+    template< class String_type >
+    typename Basic_cursor< String_type >::Iter_type Basic_cursor< String_type >::posn() const
+    {
+        return i_;
+    }
+
+    template< class String_type >
+    void Basic_cursor< String_type >::skip_spaces()
+    {
+        while( i_ != end_ && internal_::is_space( *i_ ) ) ++i_;
+    }
+
+    template< class String_type >
+    bool Basic_cursor< String_type >::is_next( char c ) const
+    {
+        return i_ != end_ && *i_ == c;
+    }
+
+    template< class String_type >
+    void Basic_cursor< String_type >::expect( char c, const char* reason )
+    {
+        if( !is_next( c ) ) throw_error( i_, reason );
+
+        ++i_;
+    }
+
+    // parses the next value with the same rules as read(), it must be of the given type
+    //
+    template< class String_type >
+    void Basic_cursor< String_type >::read_scalar( Scalar_actions& scalar, json_spirit::Value_type type, const char* reason )
+    {
+        const json_spirit::Value_type next_type = this->type();
+
+        if( next_type != type && !( type == real_type && next_type == int_type ) ) throw_error( i_, reason );
+
+        internal_::Json_parser< Scalar_actions, Iter_type > parser( scalar, i_, end_ );
+
+        if( !parser.parse() ) throw_error( parser.posn(), parser.error_reason() );
+
+        i_ = parser.posn();
+    }
+
+    template< class String_type >
+    const internal_::Number& Basic_cursor< String_type >::read_number( bool integer )
+    {
+        const char* const reason = integer ? "not an integer" : "not a number";
+
+        skip_spaces();
+
+        const Iter_type number_begin = i_;
+
+        read_scalar( scalar_, real_type, reason );
+
+        if( integer && scalar_.type_ == real_type ) throw_error( number_begin, reason );
+
+        return scalar_.number_;
+    }
+
+    // strings are skipped without decoding them, or checking their escape sequences
+    //
+    template< class String_type >
+    void Basic_cursor< String_type >::skip_str()
+    {
+        const Iter_type str_begin = i_;
+
+        for( ++i_; i_ != end_; ++i_ )
+        {
+            if( *i_ == '"' )
+            {
+                ++i_;
+                return;
+            }
+
+            if( *i_ == '\\' && ++i_ == end_ ) break;
+        }
+
+        throw_error( str_begin, "not a value" );
+    }
+
+    // finds the matching closing bracket, skipping over strings
+    //
+    template< class String_type >
+    void Basic_cursor< String_type >::skip_compound()
+    {
+        const Iter_type compound_begin = i_;
+
+        unsigned int depth = 0;
+
+        while( i_ != end_ )
+        {
+            const Char_type c = *i_;
+
+            if( c == '"' )
+            {
+                skip_str();
+                continue;
+            }
+
+            ++i_;
+
+            if( c == '{' || c == '[' )
+            {
+                ++depth;
+            }
+            else if( ( c == '}' || c == ']' ) && --depth == 0 )
+            {
+                return;
+            }
+        }
+
+        throw_error( compound_begin, *compound_begin == '{' ? "not an object" : "not an array" );
+    }
+
+    template< class String_type >
+    void Basic_cursor< String_type >::throw_error( Iter_type posn, const char* reason ) const
+    {
+        throw internal_::get_error_position( begin_, end_, posn, reason );
+    }
+}
+
+#endif
@@ -0,0 +1,479 @@
+#ifndef JASON_SPIRIT_FLAT_OBJECT
+#define JASON_SPIRIT_FLAT_OBJECT
+
+//          Copyright John W. Wilkinson 2007 - 2009.
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+// json spirit version 4.02
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include "json_spirit_value.h"
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace json_spirit
+{
+    // An object whose members are kept in a vector sorted by name. It takes no more memory than
+    // a vector object, is iterated as quickly, and finds its members by binary search. As for a
+    // map object the members are visited in the order of their names and each name occurs once.
+    //
+    // Adding a member with operator[] or insert() moves the members after it, so an object that
+    // is being built should be appended to and then sorted. The reader does this, appending each
+    // member as it is read and sorting the object when its closing brace is read. Until sort() is
+    // called the appended members follow the sorted ones in the order they were added, are found
+    // by searching them in turn and are counted by size() even if their names are repeated. sort()
+    // keeps the last of several members with the same name, as adding them to a map object does.
+    //
+    template< class Key, class Mapped >
+    class Flat_object
+    {
+    public:
+
+        typedef Key                         key_type;
+        typedef Mapped                      mapped_type;
+        typedef std::pair< Key, Mapped >    value_type;
+        typedef value_type&                 reference;
+        typedef const value_type&           const_reference;
+
+    private:
+
+        typedef std::vector< value_type > Members;
+
+    public:
+
+        typedef typename Members::size_type      size_type;
+        typedef typename Members::iterator       iterator;
+        typedef typename Members::const_iterator const_iterator;
+
+        Flat_object();
+
+        iterator       begin();
+        iterator       end();
+        const_iterator begin() const;
+        const_iterator end()   const;
+
+        size_type size()  const;
+        bool      empty() const;
+
+        void clear();
+        void reserve( size_type n );
+        void swap( Flat_object& other );
+
+        iterator       find( const Key& key );
+        const_iterator find( const Key& key ) const;
+        size_type      count( const Key& key ) const;
+
+        Mapped& operator[]( const Key& key );
+
+        // a member that is not inserted, as its name is already present, is left unchanged
+
+        std::pair< iterator, bool > insert( const value_type& member );
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        std::pair< iterator, bool > insert( value_type&& member );
+#endif
+
+        size_type erase( const Key& key );  // erases every member with the name
+        iterator  erase( iterator i );
+
+        void append( const value_type& member );
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        void append( value_type&& member );
+#endif
+
+        void sort();
+        bool is_sorted() const;
+
+        bool operator==( const Flat_object& other ) const;
+        bool operator!=( const Flat_object& other ) const;
+
+    private:
+
+        struct Name_less
+        {
+            bool operator()( const value_type& lhs, const value_type& rhs ) const { return lhs.first < rhs.first; }
+            bool operator()( const value_type& lhs, const Key& rhs )        const { return lhs.first < rhs;       }
+            bool operator()( const Key& lhs, const value_type& rhs )        const { return lhs < rhs.first;       }
+        };
+
+        struct Not_less
+        {
+            bool operator()( const value_type& lhs, const value_type& rhs ) const { return !( lhs.first < rhs.first ); }
+        };
+
+        static const size_type max_insertion_sort_size = 32;
+
+        size_type find_( const Key& key ) const;              // the member's position, or size() if there is none
+        size_type insert_position( const Key& key ) const;  // where a member that is not present is inserted
+
+        static void move_member( value_type& to, value_type& from );
+
+        Members members_;
+        size_type nb_sorted_;  // the members before this position are sorted, those after it have been appended
+    };
+
+    // objects that are sorted vectors, see Flat_object above
+
+    template< class String >
+    struct Config_flat
+    {
+        typedef String String_type;
+        typedef Value_impl< Config_flat > Value_type;
+        typedef std::vector< Value_type > Array_type;
+        typedef Flat_object< String_type, Value_type > Object_type;
+        typedef typename Object_type::value_type Pair_type;
+
+        // members are appended as they are read, each object is sorted when it ends
+
+        static Value_type& add( Object_type& obj, const String_type& name, const Value_type& value )
+        {
+            obj.append( Pair_type( name, value ) );
+
+            return ( obj.end() - 1 )->second;
+        }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        static Value_type& add( Object_type& obj, String_type&& name, Value_type&& value )
+        {
+            obj.append( Pair_type( std::move( name ), std::move( value ) ) );
+
+            return ( obj.end() - 1 )->second;
+        }
+#endif
+
+        static const String_type& get_name( const Pair_type& pair )
+        {
+            return pair.first;
+        }
+
+        static const Value_type& get_value( const Pair_type& pair )
+        {
+            return pair.second;
+        }
+    };
+
+    // typedefs for ASCII
+
+    typedef Config_flat< std::string > fConfig;
+
+    typedef fConfig::Value_type  fValue;
+    typedef fConfig::Object_type fObject;
+    typedef fConfig::Array_type  fArray;
+
+    // typedefs for Unicode
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    typedef Config_flat< std::wstring > wfConfig;
+
+    typedef wfConfig::Value_type  wfValue;
+    typedef wfConfig::Object_type wfObject;
+    typedef wfConfig::Array_type  wfArray;
+
+#endif
+
+    namespace internal_
+    {
+        // called by the reader when an object's closing brace is read, only a Flat_object
+        // has anything to finish
+
+        template< class Object_type >
+        void finish_obj( Object_type& )
+        {
+        }
+
+        template< class Key, class Mapped >
+        void finish_obj( Flat_object< Key, Mapped >& obj )
+        {
+            obj.sort();
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // implementation
+
+    template< class Key, class Mapped >
+    Flat_object< Key, Mapped >::Flat_object()
+    :   nb_sorted_( 0 )
+    {
+    }
+
+    template< class Key, class Mapped >
+    typename Flat_object< Key, Mapped >::iterator Flat_object< Key, Mapped >::begin()
+    {
+        return members_.begin();
+    }
+
+    template< class Key, class Mapped >
+    typename Flat_object< Key, Mapped >::iterator Flat_object< Key, Mapped >::end()
+    {
+        return members_.end();
+    }
+
+    template< class Key, class Mapped >
+    typename Flat_object< Key, Mapped >::const_iterator Flat_object< Key, Mapped >::begin() const
+    {
+        return members_.begin();
+    }
+
+    template< class Key, class Mapped >
+    typename Flat_object< Key, Mapped >::const_iterator Flat_object< Key, Mapped >::end() const
+    {
+        return members_.end();
+    }
+
+    template< class Key, class Mapped >
+    typename Flat_object< Key, Mapped >::size_type Flat_object< Key, Mapped >::size() const
+    {
+        return members_.size();
+    }
+
+    template< class Key, class Mapped >
+    bool Flat_object< Key, Mapped >::empty() const
+    {
+        return members_.empty();
+    }
+
+    template< class Key, class Mapped >
+    void Flat_object< Key, Mapped >::clear()
+    {
+        members_.clear();
+
+        nb_sorted_ = 0;
+    }
+
+    template< class Key, class Mapped >
+    void Flat_object< Key, Mapped >::reserve( size_type n )
+    {
+        members_.reserve( n );
+    }
+
+    template< class Key, class Mapped >
+    void Flat_object< Key, Mapped >::swap( Flat_object& other )
+    {
+        members_.swap( other.members_ );
+
+        std::swap( nb_sorted_, other.nb_sorted_ );
+    }
+
+    template< class Key, class Mapped >
+    typename Flat_object< Key, Mapped >::iterator Flat_object< Key, Mapped >::find( const Key& key )
+    {
+        return members_.begin() + find_( key );
+    }
+
+    template< class Key, class Mapped >
+    typename Flat_object< Key, Mapped >::const_iterator Flat_object< Key, Mapped >::find( const Key& key ) const
+    {
+        return members_.begin() + find_( key );
+    }
+
+    template< class Key, class Mapped >
+    typename Flat_object< Key, Mapped >::size_type Flat_object< Key, Mapped >::count( const Key& key ) const
+    {
+        return find_( key ) != members_.size() ? 1 : 0;
+    }
+
+    template< class Key, class Mapped >
+    Mapped& Flat_object< Key, Mapped >::operator[]( const Key& key )
+    {
+        const size_type pos = find_( key );
+
+        if( pos != members_.size() ) return members_[ pos ].second;
+
+        return insert( value_type( key, Mapped() ) ).first->second;
+    }
+
+    template< class Key, class Mapped >
+    std::pair< typename Flat_object< Key, Mapped >::iterator, bool > Flat_object< Key, Mapped >::insert( const value_type& member )
+    {
+        const size_type pos = find_( member.first );
+
+        if( pos != members_.size() ) return std::make_pair( members_.begin() + pos, false );
+
+        const bool was_sorted = is_sorted();
+        const size_type new_pos = insert_position( member.first );
+
+        members_.insert( members_.begin() + new_pos, member );
+
+        if( was_sorted ) ++nb_sorted_;
+
+        return std::make_pair( members_.begin() + new_pos, true );
+    }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    template< class Key, class Mapped >
+    std::pair< typename Flat_object< Key, Mapped >::iterator, bool > Flat_object< Key, Mapped >::insert( value_type&& member )
+    {
+        const size_type pos = find_( member.first );
+
+        if( pos != members_.size() ) return std::make_pair( members_.begin() + pos, false );
+
+        const bool was_sorted = is_sorted();
+        const size_type new_pos = insert_position( member.first );
+
+        members_.insert( members_.begin() + new_pos, std::move( member ) );
+
+        if( was_sorted ) ++nb_sorted_;
+
+        return std::make_pair( members_.begin() + new_pos, true );
+    }
+#endif
+
+    template< class Key, class Mapped >
+    typename Flat_object< Key, Mapped >::size_type Flat_object< Key, Mapped >::erase( const Key& key )
+    {
+        size_type nb_erased = 0;
+
+        for( size_type pos = find_( key ); pos != members_.size(); pos = find_( key ) )
+        {
+            erase( members_.begin() + pos );
+
+            ++nb_erased;
+        }
+
+        return nb_erased;
+    }
+
+    template< class Key, class Mapped >
+    typename Flat_object< Key, Mapped >::iterator Flat_object< Key, Mapped >::erase( iterator i )
+    {
+        if( size_type( i - members_.begin() ) < nb_sorted_ ) --nb_sorted_;
+
+        return members_.erase( i );
+    }
+
+    template< class Key, class Mapped >
+    void Flat_object< Key, Mapped >::append( const value_type& member )
+    {
+        members_.push_back( member );
+    }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    template< class Key, class Mapped >
+    void Flat_object< Key, Mapped >::append( value_type&& member )
+    {
+        members_.push_back( std::move( member ) );
+    }
+#endif
+
+    template< class Key, class Mapped >
+    void Flat_object< Key, Mapped >::sort()
+    {
+        if( is_sorted() ) return;
+
+        // members with the same name must be kept in the order they were added, the members of
+        // most objects are already in order or few enough to be sorted in place without allocating
+
+        if( std::adjacent_find( members_.begin(), members_.end(), Not_less() ) == members_.end() )
+        {
+            nb_sorted_ = members_.size();
+
+            return;
+        }
+
+        if( members_.size() <= max_insertion_sort_size )
+        {
+            for( iterator i = members_.begin() + 1; i != members_.end(); ++i )
+            {
+                std::rotate( std::upper_bound( members_.begin(), i, *i, Name_less() ), i, i + 1 );
+            }
+        }
+        else
+        {
+            std::stable_sort( members_.begin(), members_.end(), Name_less() );
+        }
+
+        size_type nb_kept = 0;
+
+        for( size_type i = 0; i < members_.size(); ++i )
+        {
+            if( nb_kept != 0 && members_[ nb_kept - 1 ].first == members_[i].first )
+            {
+                move_member( members_[ nb_kept - 1 ], members_[i] );  // the later member replaces the earlier
+            }
+            else
+            {
+                if( nb_kept != i ) move_member( members_[ nb_kept ], members_[i] );
+
+                ++nb_kept;
+            }
+        }
+
+        members_.erase( members_.begin() + nb_kept, members_.end() );
+
+        nb_sorted_ = nb_kept;
+    }
+
+    template< class Key, class Mapped >
+    bool Flat_object< Key, Mapped >::is_sorted() const
+    {
+        return nb_sorted_ == members_.size();
+    }
+
+    template< class Key, class Mapped >
+    bool Flat_object< Key, Mapped >::operator==( const Flat_object& other ) const
+    {
+        if( is_sorted() && other.is_sorted() ) return members_ == other.members_;
+
+        Flat_object lhs( *this );
+        Flat_object rhs( other );
+
+        lhs.sort();
+        rhs.sort();
+
+        return lhs.members_ == rhs.members_;
+    }
+
+    template< class Key, class Mapped >
+    bool Flat_object< Key, Mapped >::operator!=( const Flat_object& other ) const
+    {
+        return !( *this == other );
+    }
+
+    template< class Key, class Mapped >
+    typename Flat_object< Key, Mapped >::size_type Flat_object< Key, Mapped >::find_( const Key& key ) const
+    {
+        for( size_type i = members_.size(); i > nb_sorted_; )  // from the last appended, as the last member with a name wins
+        {
+            --i;
+
+            if( members_[i].first == key ) return i;
+        }
+
+        const const_iterator sorted_end = members_.begin() + nb_sorted_;
+
+        const const_iterator i = std::lower_bound( members_.begin(), sorted_end, key, Name_less() );
+
+        if( i != sorted_end && i->first == key ) return i - members_.begin();
+
+        return members_.size();
+    }
+
+    template< class Key, class Mapped >
+    typename Flat_object< Key, Mapped >::size_type Flat_object< Key, Mapped >::insert_position( const Key& key ) const
+    {
+        if( !is_sorted() ) return members_.size();  // appended, to be sorted with the others
+
+        return std::lower_bound( members_.begin(), members_.end(), key, Name_less() ) - members_.begin();
+    }
+
+    template< class Key, class Mapped >
+    void Flat_object< Key, Mapped >::move_member( value_type& to, value_type& from )
+    {
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        to = std::move( from );
+#else
+        to = from;
+#endif
+    }
+}
+
+#endif
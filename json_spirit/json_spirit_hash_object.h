@@ -0,0 +1,438 @@
+#ifndef JASON_SPIRIT_HASH_OBJECT
+#define JASON_SPIRIT_HASH_OBJECT
+
+//          Copyright John W. Wilkinson 2007 - 2009.
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+// json spirit version 4.02
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include "json_spirit_value.h"
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <boost/functional/hash.hpp>
+
+namespace json_spirit
+{
+    // An object that keeps its members in the order they were added, like a vector object, and
+    // finds them by name in constant time, like a map object but without a node per member. The
+    // members are stored contiguously and a table of their positions is searched by open addressing
+    // with linear probing. The hash of each name is kept beside the member, so that growing the
+    // table does not hash the names again and most mismatches are rejected without comparing them.
+    // Small objects have no table, their hashes are searched in turn.
+    //
+    // Each name occurs once, operator[] and insert() find an existing member as std::map does.
+    // Erasing a member keeps the order of the rest, which takes time proportional to the size of
+    // the object. Names must not be changed through an iterator. Objects are equal if they have
+    // the same members, in any order.
+    //
+    template< class Key, class Mapped >
+    class Hash_object
+    {
+    public:
+
+        typedef Key                         key_type;
+        typedef Mapped                      mapped_type;
+        typedef std::pair< Key, Mapped >    value_type;
+        typedef value_type&                 reference;
+        typedef const value_type&           const_reference;
+
+    private:
+
+        typedef std::vector< value_type > Members;
+
+    public:
+
+        typedef typename Members::size_type      size_type;
+        typedef typename Members::iterator       iterator;
+        typedef typename Members::const_iterator const_iterator;
+
+        iterator       begin();
+        iterator       end();
+        const_iterator begin() const;
+        const_iterator end()   const;
+
+        size_type size()  const;
+        bool      empty() const;
+
+        void clear();
+        void reserve( size_type n );
+        void swap( Hash_object& other );
+
+        iterator       find( const Key& key );
+        const_iterator find( const Key& key ) const;
+        size_type      count( const Key& key ) const;
+
+        Mapped& operator[]( const Key& key );
+
+        // a member that is not inserted, as its name is already present, is left unchanged
+
+        std::pair< iterator, bool > insert( const value_type& member );
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        std::pair< iterator, bool > insert( value_type&& member );
+#endif
+
+        size_type erase( const Key& key );
+        iterator  erase( iterator i );
+
+        bool operator==( const Hash_object& other ) const;
+        bool operator!=( const Hash_object& other ) const;
+
+    private:
+
+        typedef std::vector< size_type > Slots;
+
+        static const size_type empty_slot = static_cast< size_type >( -1 );
+        static const size_type max_unindexed_size = 8;
+
+        static std::size_t hash( const Key& key );
+
+        size_type find_( const Key& key, std::size_t h ) const;  // the member's position, or empty_slot
+        std::pair< iterator, bool > added( std::size_t h );       // indexes the member just pushed back
+
+        void place( Slots& slots, size_type pos ) const;
+        void rebuild_slots( size_type nb_slots );
+
+        Members members_;
+        std::vector< std::size_t > hashes_;  // of the members' names
+        Slots slots_;                        // positions of the members, at most half full, a power of 2 in size,
+                                             // or empty if there are at most max_unindexed_size members
+    };
+
+    // objects that find their members through a hash table, see Hash_object above
+
+    template< class String >
+    struct Config_hash
+    {
+        typedef String String_type;
+        typedef Value_impl< Config_hash > Value_type;
+        typedef std::vector< Value_type > Array_type;
+        typedef Hash_object< String_type, Value_type > Object_type;
+        typedef typename Object_type::value_type Pair_type;
+
+        static Value_type& add( Object_type& obj, const String_type& name, const Value_type& value )
+        {
+            return obj[ name ] = value;
+        }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        static Value_type& add( Object_type& obj, String_type&& name, Value_type&& value )
+        {
+            Pair_type member( std::move( name ), std::move( value ) );
+
+            const std::pair< typename Object_type::iterator, bool > result = obj.insert( std::move( member ) );
+
+            if( !result.second ) result.first->second = std::move( member.second );  // last one wins, as for map objects
+
+            return result.first->second;
+        }
+#endif
+
+        static const String_type& get_name( const Pair_type& pair )
+        {
+            return pair.first;
+        }
+
+        static const Value_type& get_value( const Pair_type& pair )
+        {
+            return pair.second;
+        }
+    };
+
+    // typedefs for ASCII
+
+    typedef Config_hash< std::string > hConfig;
+
+    typedef hConfig::Value_type  hValue;
+    typedef hConfig::Object_type hObject;
+    typedef hConfig::Array_type  hArray;
+
+    // typedefs for Unicode
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    typedef Config_hash< std::wstring > whConfig;
+
+    typedef whConfig::Value_type  whValue;
+    typedef whConfig::Object_type whObject;
+    typedef whConfig::Array_type  whArray;
+
+#endif
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // implementation
+
+    template< class Key, class Mapped >
+    typename Hash_object< Key, Mapped >::iterator Hash_object< Key, Mapped >::begin()
+    {
+        return members_.begin();
+    }
+
+    template< class Key, class Mapped >
+    typename Hash_object< Key, Mapped >::iterator Hash_object< Key, Mapped >::end()
+    {
+        return members_.end();
+    }
+
+    template< class Key, class Mapped >
+    typename Hash_object< Key, Mapped >::const_iterator Hash_object< Key, Mapped >::begin() const
+    {
+        return members_.begin();
+    }
+
+    template< class Key, class Mapped >
+    typename Hash_object< Key, Mapped >::const_iterator Hash_object< Key, Mapped >::end() const
+    {
+        return members_.end();
+    }
+
+    template< class Key, class Mapped >
+    typename Hash_object< Key, Mapped >::size_type Hash_object< Key, Mapped >::size() const
+    {
+        return members_.size();
+    }
+
+    template< class Key, class Mapped >
+    bool Hash_object< Key, Mapped >::empty() const
+    {
+        return members_.empty();
+    }
+
+    template< class Key, class Mapped >
+    void Hash_object< Key, Mapped >::clear()
+    {
+        members_.clear();
+        hashes_.clear();
+        slots_.clear();
+    }
+
+    template< class Key, class Mapped >
+    void Hash_object< Key, Mapped >::reserve( size_type n )
+    {
+        members_.reserve( n );
+        hashes_.reserve( n );
+
+        if( n <= max_unindexed_size ) return;
+
+        size_type nb_slots = ( std::max )( slots_.size(), 2 * size_type( max_unindexed_size ) );
+
+        while( nb_slots < 2 * n ) nb_slots *= 2;
+
+        if( nb_slots != slots_.size() ) rebuild_slots( nb_slots );
+    }
+
+    template< class Key, class Mapped >
+    void Hash_object< Key, Mapped >::swap( Hash_object& other )
+    {
+        members_.swap( other.members_ );
+        hashes_.swap( other.hashes_ );
+        slots_.swap( other.slots_ );
+    }
+
+    template< class Key, class Mapped >
+    typename Hash_object< Key, Mapped >::iterator Hash_object< Key, Mapped >::find( const Key& key )
+    {
+        const size_type pos = find_( key, hash( key ) );
+
+        return pos != empty_slot ? members_.begin() + pos : members_.end();
+    }
+
+    template< class Key, class Mapped >
+    typename Hash_object< Key, Mapped >::const_iterator Hash_object< Key, Mapped >::find( const Key& key ) const
+    {
+        const size_type pos = find_( key, hash( key ) );
+
+        return pos != empty_slot ? members_.begin() + pos : members_.end();
+    }
+
+    template< class Key, class Mapped >
+    typename Hash_object< Key, Mapped >::size_type Hash_object< Key, Mapped >::count( const Key& key ) const
+    {
+        return find_( key, hash( key ) ) != empty_slot ? 1 : 0;
+    }
+
+    template< class Key, class Mapped >
+    Mapped& Hash_object< Key, Mapped >::operator[]( const Key& key )
+    {
+        const std::size_t h = hash( key );
+
+        const size_type pos = find_( key, h );
+
+        if( pos != empty_slot ) return members_[ pos ].second;
+
+        members_.push_back( value_type( key, Mapped() ) );
+
+        return added( h ).first->second;
+    }
+
+    template< class Key, class Mapped >
+    std::pair< typename Hash_object< Key, Mapped >::iterator, bool > Hash_object< Key, Mapped >::insert( const value_type& member )
+    {
+        const std::size_t h = hash( member.first );
+
+        const size_type pos = find_( member.first, h );
+
+        if( pos != empty_slot ) return std::make_pair( members_.begin() + pos, false );
+
+        members_.push_back( member );
+
+        return added( h );
+    }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    template< class Key, class Mapped >
+    std::pair< typename Hash_object< Key, Mapped >::iterator, bool > Hash_object< Key, Mapped >::insert( value_type&& member )
+    {
+        const std::size_t h = hash( member.first );
+
+        const size_type pos = find_( member.first, h );
+
+        if( pos != empty_slot ) return std::make_pair( members_.begin() + pos, false );
+
+        members_.push_back( std::move( member ) );
+
+        return added( h );
+    }
+#endif
+
+    template< class Key, class Mapped >
+    typename Hash_object< Key, Mapped >::size_type Hash_object< Key, Mapped >::erase( const Key& key )
+    {
+        const iterator i = find( key );
+
+        if( i == end() ) return 0;
+
+        erase( i );
+
+        return 1;
+    }
+
+    template< class Key, class Mapped >
+    typename Hash_object< Key, Mapped >::iterator Hash_object< Key, Mapped >::erase( iterator i )
+    {
+        const size_type pos = i - members_.begin();
+
+        members_.erase( i );
+        hashes_.erase( hashes_.begin() + pos );
+
+        if( !slots_.empty() ) rebuild_slots( slots_.size() );  // the positions of the following members have changed
+
+        return members_.begin() + pos;
+    }
+
+    template< class Key, class Mapped >
+    bool Hash_object< Key, Mapped >::operator==( const Hash_object& other ) const
+    {
+        if( size() != other.size() ) return false;
+
+        for( size_type i = 0; i < members_.size(); ++i )
+        {
+            const size_type pos = other.find_( members_[i].first, hashes_[i] );
+
+            if( pos == empty_slot || !( other.members_[ pos ].second == members_[i].second ) ) return false;
+        }
+
+        return true;
+    }
+
+    template< class Key, class Mapped >
+    bool Hash_object< Key, Mapped >::operator!=( const Hash_object& other ) const
+    {
+        return !( *this == other );
+    }
+
+    template< class Key, class Mapped >
+    std::size_t Hash_object< Key, Mapped >::hash( const Key& key )
+    {
+        return boost::hash_range( key.begin(), key.end() );
+    }
+
+    template< class Key, class Mapped >
+    typename Hash_object< Key, Mapped >::size_type Hash_object< Key, Mapped >::find_( const Key& key, std::size_t h ) const
+    {
+        if( slots_.empty() )
+        {
+            for( size_type pos = 0; pos < members_.size(); ++pos )
+            {
+                if( hashes_[ pos ] == h && members_[ pos ].first == key ) return pos;
+            }
+
+            return empty_slot;
+        }
+
+        const std::size_t mask = slots_.size() - 1;
+
+        for( std::size_t i = h & mask; slots_[i] != empty_slot; i = ( i + 1 ) & mask )
+        {
+            const size_type pos = slots_[i];
+
+            if( hashes_[ pos ] == h && members_[ pos ].first == key ) return pos;
+        }
+
+        return empty_slot;
+    }
+
+    template< class Key, class Mapped >
+    std::pair< typename Hash_object< Key, Mapped >::iterator, bool > Hash_object< Key, Mapped >::added( std::size_t h )
+    {
+        try  // the member is taken back if it cannot be indexed, so that none is left that lookups would miss
+        {
+            hashes_.push_back( h );
+
+            if( members_.size() > max_unindexed_size && 2 * members_.size() > slots_.size() )
+            {
+                rebuild_slots( slots_.empty() ? 4 * size_type( max_unindexed_size ) : 2 * slots_.size() );
+
+                return std::make_pair( members_.end() - 1, true );
+            }
+        }
+        catch( ... )
+        {
+            if( hashes_.size() == members_.size() ) hashes_.pop_back();
+
+            members_.pop_back();
+            throw;
+        }
+
+        if( !slots_.empty() )
+        {
+            place( slots_, members_.size() - 1 );
+        }
+
+        return std::make_pair( members_.end() - 1, true );
+    }
+
+    template< class Key, class Mapped >
+    void Hash_object< Key, Mapped >::place( Slots& slots, size_type pos ) const
+    {
+        const std::size_t mask = slots.size() - 1;
+
+        std::size_t i = hashes_[ pos ] & mask;
+
+        while( slots[i] != empty_slot ) i = ( i + 1 ) & mask;
+
+        slots[i] = pos;
+    }
+
+    template< class Key, class Mapped >
+    void Hash_object< Key, Mapped >::rebuild_slots( size_type nb_slots )
+    {
+        Slots slots( nb_slots, size_type( empty_slot ) );  // built aside, so that a failure leaves the object unchanged
+
+        for( size_type i = 0; i < members_.size(); ++i )
+        {
+            place( slots, i );
+        }
+
+        slots_.swap( slots );
+    }
+}
+
+#endif
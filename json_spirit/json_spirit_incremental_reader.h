@@ -0,0 +1,486 @@
+#ifndef JASON_SPIRIT_INCREMENTAL_READER
+#define JASON_SPIRIT_INCREMENTAL_READER
+
+//          Copyright John W. Wilkinson 2007 - 2009.
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+// json spirit version 4.02
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include "json_spirit_reader_template.h"
+
+#include <string>
+#include <vector>
+
+namespace json_spirit
+{
+    // An Incremental_reader reads a value from text that arrives a piece at a time, eg. from
+    // a network connection, parsing each piece as it is fed in, eg.
+    //
+    //    mValue value;
+    //    Incremental_reader< mValue > reader( value );
+    //    while( receive( chunk ) ) reader.feed( chunk );
+    //    reader.finish();
+    //
+    // The text may be split anywhere, including inside strings, numbers and escape sequences.
+    // The value built, and any error, is the same as read() would give for the whole text,
+    // except that text after the value other than white space is an error. A number at the
+    // end of the text is only complete once finish() is called. Errors are thrown as
+    // Error_positions. The strings of a vValue would refer to text that is not kept, so
+    // vValues cannot be read incrementally.
+    //
+    template< class Value_type >
+    class Incremental_reader
+    {
+    public:
+
+        typedef typename Value_type::Config_type::String_type String_type;
+        typedef typename String_type::value_type Char_type;
+        typedef std::basic_string< Char_type > Text_type;
+
+        explicit Incremental_reader( Value_type& value );
+
+        void feed( const Char_type* begin, const Char_type* end );
+        void feed( const Text_type& s );
+        void finish();  // throws if the text so far does not hold a complete value
+
+        bool is_complete() const;  // true once the value has been read
+
+    private:
+
+        enum State{ value_expected, key_expected, colon_expected, separator_expected,
+                    in_string, in_escape, in_hex_escape, after_high_hex_digit, in_literal, in_number,
+                    complete, failed };
+
+        // where the value or key being read is, which decides the error reported if it is malformed
+
+        enum Context{ top_level, first_element, next_element, pair_value, first_key, next_key };
+
+        struct Position
+        {
+            unsigned int line_;
+            unsigned int column_;
+        };
+
+        typedef internal_::Semantic_actions< Value_type, const Char_type* > Actions_type;
+
+        void consume( Char_type c );
+        void advance( Char_type c );
+        void begin_value( Char_type c );
+        void begin_key( Char_type c );
+        void begin_token( Char_type c, State state );
+        void next_or_end( Char_type c );
+        void consume_str_char( Char_type c );
+        void end_str();
+        void end_literal();
+        void end_number();
+        void end_compound( Char_type c );
+        void end_value();
+        void fail_token();
+        void fail_after_value( const Position& posn );
+        void fail( const Position& posn, const char* reason );
+
+        Actions_type actions_;
+        State state_;
+        Context context_;
+        std::vector< char > compounds_;  // the '{' or '[' of each enclosing object or array
+        Text_type token_;                // the characters of the string, literal or number being read
+        const char* literal_;            // the literal being read
+        bool is_key_;                    // true if the string being read is a name
+        Position posn_;                  // of the next character
+        Position token_posn_;
+        Position comma_posn_;            // of the last comma
+        bool after_cr_;
+        Error_position error_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // implementation
+
+    template< class Value_type >
+    Incremental_reader< Value_type >::Incremental_reader( Value_type& value )
+    :   actions_( value )
+    ,   state_( value_expected )
+    ,   context_( top_level )
+    ,   literal_( 0 )
+    ,   is_key_( false )
+    ,   after_cr_( false )
+    {
+        posn_.line_   = 1;
+        posn_.column_ = 1;
+
+        token_posn_ = comma_posn_ = posn_;
+    }
+
+    template< class Value_type >
+    void Incremental_reader< Value_type >::feed( const Char_type* begin, const Char_type* end )
+    {
+        if( state_ == failed ) throw error_;
+
+        for( ; begin != end; ++begin )
+        {
+            consume( *begin );
+            advance( *begin );
+        }
+    }
+
+    template< class Value_type >
+    void Incremental_reader< Value_type >::feed( const Text_type& s )
+    {
+        feed( s.data(), s.data() + s.size() );
+    }
+
+    template< class Value_type >
+    void Incremental_reader< Value_type >::finish()
+    {
+        if( state_ == in_number ) end_number();
+
+        switch( state_ )
+        {
+            case complete:
+                return;
+
+            case failed:
+                throw error_;
+
+            case value_expected:
+            case key_expected:
+                token_posn_ = posn_;
+                fail_token();
+                return;
+
+            case colon_expected:
+                fail( posn_, "no colon in pair" );
+                return;
+
+            case separator_expected:
+                fail( posn_, compounds_.back() == '[' ? "not an array" : "not an object" );
+                return;
+
+            default:  // inside a string or literal
+                fail_token();
+        }
+    }
+
+    template< class Value_type >
+    bool Incremental_reader< Value_type >::is_complete() const
+    {
+        return state_ == complete;
+    }
+
+    // follows the rules of Json_parser, see json_spirit_reader_template.h
+    //
+    template< class Value_type >
+    void Incremental_reader< Value_type >::consume( Char_type c )
+    {
+        switch( state_ )
+        {
+            case in_string:
+                consume_str_char( c );
+                return;
+
+            case in_escape:
+                token_ += c;
+                state_ = ( c == 'x' || c == 'X' ) ? in_hex_escape : in_string;
+                return;
+
+            case in_hex_escape:  // only hex escapes that fit in a signed char are accepted, as for Json_parser
+                if( !internal_::is_hex_digit( c ) ) fail_token();
+                token_ += c;
+                state_ = internal_::hex_to_num( c ) >= 8 ? after_high_hex_digit : in_string;
+                return;
+
+            case after_high_hex_digit:
+                if( internal_::is_hex_digit( c ) ) fail_token();
+                consume_str_char( c );
+                return;
+
+            case in_literal:
+                if( c != literal_[ token_.size() ] ) fail_token();
+                token_ += c;
+                if( literal_[ token_.size() ] == 0 ) end_literal();
+                return;
+
+            case in_number:
+                if( ( c >= '0' && c <= '9' ) || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-' )
+                {
+                    token_ += c;
+                    return;
+                }
+                end_number();
+                break;  // c follows the number
+
+            default:
+                break;
+        }
+
+        if( internal_::is_space( c ) ) return;
+
+        switch( state_ )
+        {
+            case value_expected:
+                begin_value( c );
+                return;
+
+            case key_expected:
+                begin_key( c );
+                return;
+
+            case colon_expected:
+                if( c != ':' ) fail( posn_, "no colon in pair" );
+                state_   = value_expected;
+                context_ = pair_value;
+                return;
+
+            case separator_expected:
+                next_or_end( c );
+                return;
+
+            default:
+                fail( posn_, "extra text after the value" );
+        }
+    }
+
+    // counts lines and columns in the same way as get_error_position()
+    //
+    template< class Value_type >
+    void Incremental_reader< Value_type >::advance( Char_type c )
+    {
+        const unsigned int tab_chars = 4;
+
+        if( c == '\r' || ( c == '\n' && !after_cr_ ) )
+        {
+            ++posn_.line_;
+            posn_.column_ = 1;
+        }
+        else if( c == '\t' )
+        {
+            posn_.column_ += tab_chars - ( posn_.column_ - 1 ) % tab_chars;
+        }
+        else if( c != '\n' )
+        {
+            ++posn_.column_;
+        }
+
+        after_cr_ = ( c == '\r' );
+    }
+
+    template< class Value_type >
+    void Incremental_reader< Value_type >::begin_value( Char_type c )
+    {
+        token_posn_ = posn_;
+
+        switch( c )
+        {
+            case '{':
+                actions_.begin_obj( c );
+                compounds_.push_back( '{' );
+                state_   = key_expected;
+                context_ = first_key;
+                return;
+
+            case '[':
+                actions_.begin_array( c );
+                compounds_.push_back( '[' );
+                state_   = value_expected;
+                context_ = first_element;
+                return;
+
+            case ']':
+                if( context_ == first_element ) end_compound( c );  // an empty array
+                else fail_token();
+                return;
+
+            case '"': is_key_ = false;   begin_token( c, in_string );  return;
+            case 't': literal_ = "true";  begin_token( c, in_literal ); return;
+            case 'f': literal_ = "false"; begin_token( c, in_literal ); return;
+            case 'n': literal_ = "null";  begin_token( c, in_literal ); return;
+        }
+
+        if( ( c >= '0' && c <= '9' ) || c == '-' || c == '+' || c == '.' )
+        {
+            begin_token( c, in_number );
+            return;
+        }
+
+        fail_token();
+    }
+
+    template< class Value_type >
+    void Incremental_reader< Value_type >::begin_key( Char_type c )
+    {
+        token_posn_ = posn_;
+
+        if( c == '"' )
+        {
+            is_key_ = true;
+            begin_token( c, in_string );
+        }
+        else if( c == '}' && context_ == first_key )  // an empty object
+        {
+            end_compound( c );
+        }
+        else
+        {
+            fail_token();
+        }
+    }
+
+    template< class Value_type >
+    void Incremental_reader< Value_type >::begin_token( Char_type c, State state )
+    {
+        token_.clear();
+        token_ += c;
+        state_ = state;
+    }
+
+    template< class Value_type >
+    void Incremental_reader< Value_type >::next_or_end( Char_type c )
+    {
+        const bool in_array = ( compounds_.back() == '[' );
+
+        if( c == ',' )
+        {
+            comma_posn_ = posn_;
+            state_   = in_array ? value_expected : key_expected;
+            context_ = in_array ? next_element   : next_key;
+        }
+        else if( c == ( in_array ? ']' : '}' ) )
+        {
+            end_compound( c );
+        }
+        else
+        {
+            fail( posn_, in_array ? "not an array" : "not an object" );
+        }
+    }
+
+    template< class Value_type >
+    void Incremental_reader< Value_type >::consume_str_char( Char_type c )
+    {
+        token_ += c;
+
+        if     ( c == '"'  ) end_str();
+        else if( c == '\\' ) state_ = in_escape;
+        else                 state_ = in_string;
+    }
+
+    template< class Value_type >
+    void Incremental_reader< Value_type >::end_str()
+    {
+        const Char_type* const begin = token_.data();
+        const Char_type* const end   = begin + token_.size();
+
+        if( is_key_ )
+        {
+            actions_.new_name( begin, end );
+            state_ = colon_expected;
+        }
+        else
+        {
+            actions_.new_str( begin, end );
+            end_value();
+        }
+    }
+
+    template< class Value_type >
+    void Incremental_reader< Value_type >::end_literal()
+    {
+        const Char_type* const begin = token_.data();
+        const Char_type* const end   = begin + token_.size();
+
+        switch( token_[0] )
+        {
+            case 't': actions_.new_true ( begin, end ); break;
+            case 'f': actions_.new_false( begin, end ); break;
+            default:  actions_.new_null ( begin, end );
+        }
+
+        end_value();
+    }
+
+    // the number is as much of the token as scan_number() accepts, as for Json_parser, the
+    // rest of the token cannot follow a value
+    //
+    template< class Value_type >
+    void Incremental_reader< Value_type >::end_number()
+    {
+        const Char_type* const begin = token_.data();
+        const Char_type* const end   = begin + token_.size();
+
+        internal_::Number number;
+
+        const Char_type* const number_end = internal_::scan_number( begin, end, number );
+
+        if( number.type_ == internal_::Number::none ) fail_token();
+
+        actions_.new_number( number );
+
+        end_value();
+
+        if( number_end != end )
+        {
+            Position posn( token_posn_ );
+
+            posn.column_ += static_cast< unsigned int >( number_end - begin );
+
+            fail_after_value( posn );
+        }
+    }
+
+    template< class Value_type >
+    void Incremental_reader< Value_type >::end_compound( Char_type c )
+    {
+        if( c == '}' ) actions_.end_obj( c );
+        else           actions_.end_array( c );
+
+        compounds_.pop_back();
+
+        end_value();
+    }
+
+    template< class Value_type >
+    void Incremental_reader< Value_type >::end_value()
+    {
+        state_ = compounds_.empty() ? complete : separator_expected;
+    }
+
+    // a value or name that is missing or malformed is reported where Json_parser reports it
+    //
+    template< class Value_type >
+    void Incremental_reader< Value_type >::fail_token()
+    {
+        switch( context_ )
+        {
+            case top_level:     fail( token_posn_, "not a value" );    break;
+            case first_element: fail( token_posn_, "not an array" );   break;
+            case next_element:  fail( comma_posn_, "not an array" );   break;
+            case pair_value:    fail( token_posn_, "not a value" );    break;
+            case first_key:     fail( token_posn_, "not an object" );  break;
+            case next_key:      fail( comma_posn_, "not an object" );  break;
+        }
+    }
+
+    template< class Value_type >
+    void Incremental_reader< Value_type >::fail_after_value( const Position& posn )
+    {
+        if( state_ == complete ) fail( posn, "extra text after the value" );
+
+        fail( posn, compounds_.back() == '[' ? "not an array" : "not an object" );
+    }
+
+    template< class Value_type >
+    void Incremental_reader< Value_type >::fail( const Position& posn, const char* reason )
+    {
+        state_ = failed;
+        error_ = Error_position( posn.line_, posn.column_, reason );
+
+        throw error_;
+    }
+}
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef JASON_SPIRIT_INTERNED_STRING
+#define JASON_SPIRIT_INTERNED_STRING
+
+//          Copyright John W. Wilkinson 2007 - 2009.
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+// json spirit version 4.02
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include <string>
+#include <cstddef>
+#include <algorithm>
+#include <ostream>
+#include <utility>
+#include <boost/config.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+namespace json_spirit
+{
+    // The string type of the "i" configs, for documents whose objects repeat the same names, eg.
+    // an array of records. An Interned_string is a handle to immutable characters that are shared
+    // by its copies. When an iValue is read, each distinct name is stored once and every member
+    // with that name holds a handle to the same characters, see internal_::Name_table. Strings
+    // that share their characters compare equal without comparing them. The strings of values
+    // are not interned, each has characters of its own: one allocation holding the reference
+    // count and a std::string, plus the string's buffer if it is too long to fit inside it.
+    //
+    template< class Char >
+    class Interned_string
+    {
+    public:
+
+        typedef Char                      value_type;
+        typedef std::char_traits< Char >  traits_type;
+        typedef const Char*               const_pointer;
+        typedef const Char*               const_iterator;
+        typedef const Char*               iterator;
+        typedef std::size_t               size_type;
+        typedef std::basic_string< Char > String_type;
+
+        Interned_string();                                      // empty
+        Interned_string( const Char* c_str );                   // copies c_str
+        Interned_string( const Char* begin, const Char* end );  // copies the characters in [begin, end)
+        Interned_string( const String_type& s );                // copies s
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        Interned_string( String_type&& s );
+#endif
+
+        const_iterator begin() const;
+        const_iterator end()   const;
+        const Char*    data()  const;
+        size_type      size()  const;
+        size_type      length() const;
+        bool           empty() const;
+        Char operator[]( size_type i ) const;
+
+        const String_type& str() const;
+
+        bool shares_text( const Interned_string& other ) const;  // true if both refer to the same characters
+
+    private:
+
+        static const String_type& empty_str();
+
+        boost::shared_ptr< const String_type > text_;  // null if empty
+    };
+
+    template< class Char >
+    bool operator==( const Interned_string< Char >& lhs, const Interned_string< Char >& rhs )
+    {
+        return lhs.shares_text( rhs ) || lhs.str() == rhs.str();
+    }
+
+    template< class Char >
+    bool operator!=( const Interned_string< Char >& lhs, const Interned_string< Char >& rhs )
+    {
+        return !( lhs == rhs );
+    }
+
+    template< class Char >
+    bool operator<( const Interned_string< Char >& lhs, const Interned_string< Char >& rhs )
+    {
+        return !lhs.shares_text( rhs ) && lhs.str() < rhs.str();
+    }
+
+    // comparisons with other strings make no copy of them
+
+    template< class Char >
+    bool operator==( const Interned_string< Char >& lhs, const std::basic_string< Char >& rhs )
+    {
+        return lhs.str() == rhs;
+    }
+
+    template< class Char >
+    bool operator==( const std::basic_string< Char >& lhs, const Interned_string< Char >& rhs )
+    {
+        return lhs == rhs.str();
+    }
+
+    template< class Char >
+    bool operator!=( const Interned_string< Char >& lhs, const std::basic_string< Char >& rhs )
+    {
+        return !( lhs == rhs );
+    }
+
+    template< class Char >
+    bool operator!=( const std::basic_string< Char >& lhs, const Interned_string< Char >& rhs )
+    {
+        return !( lhs == rhs );
+    }
+
+    template< class Char >
+    bool operator==( const Interned_string< Char >& lhs, const Char* rhs )
+    {
+        return lhs.str() == rhs;
+    }
+
+    template< class Char >
+    bool operator==( const Char* lhs, const Interned_string< Char >& rhs )
+    {
+        return lhs == rhs.str();
+    }
+
+    template< class Char >
+    bool operator!=( const Interned_string< Char >& lhs, const Char* rhs )
+    {
+        return !( lhs == rhs );
+    }
+
+    template< class Char >
+    bool operator!=( const Char* lhs, const Interned_string< Char >& rhs )
+    {
+        return !( lhs == rhs );
+    }
+
+    template< class Char >
+    std::basic_ostream< Char >& operator<<( std::basic_ostream< Char >& os, const Interned_string< Char >& s )
+    {
+        return os << s.str();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // implementation
+
+    template< class Char >
+    Interned_string< Char >::Interned_string()
+    {
+    }
+
+    template< class Char >
+    Interned_string< Char >::Interned_string( const Char* c_str )
+    {
+        if( *c_str != 0 ) text_ = boost::make_shared< String_type >( c_str );
+    }
+
+    template< class Char >
+    Interned_string< Char >::Interned_string( const Char* begin, const Char* end )
+    {
+        if( begin != end ) text_ = boost::make_shared< String_type >( begin, end );
+    }
+
+    template< class Char >
+    Interned_string< Char >::Interned_string( const String_type& s )
+    {
+        if( !s.empty() ) text_ = boost::make_shared< String_type >( s );
+    }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    template< class Char >
+    Interned_string< Char >::Interned_string( String_type&& s )
+    {
+        if( !s.empty() ) text_ = boost::make_shared< String_type >( std::move( s ) );
+    }
+#endif
+
+    template< class Char >
+    typename Interned_string< Char >::const_iterator Interned_string< Char >::begin() const
+    {
+        return data();
+    }
+
+    template< class Char >
+    typename Interned_string< Char >::const_iterator Interned_string< Char >::end() const
+    {
+        return data() + size();
+    }
+
+    template< class Char >
+    const Char* Interned_string< Char >::data() const
+    {
+        return str().data();
+    }
+
+    template< class Char >
+    typename Interned_string< Char >::size_type Interned_string< Char >::size() const
+    {
+        return str().size();
+    }
+
+    template< class Char >
+    typename Interned_string< Char >::size_type Interned_string< Char >::length() const
+    {
+        return size();
+    }
+
+    template< class Char >
+    bool Interned_string< Char >::empty() const
+    {
+        return text_.get() == 0;
+    }
+
+    template< class Char >
+    Char Interned_string< Char >::operator[]( size_type i ) const
+    {
+        return str()[ i ];
+    }
+
+    template< class Char >
+    const typename Interned_string< Char >::String_type& Interned_string< Char >::str() const
+    {
+        return text_.get() != 0 ? *text_ : empty_str();
+    }
+
+    template< class Char >
+    bool Interned_string< Char >::shares_text( const Interned_string& other ) const
+    {
+        return text_ == other.text_;
+    }
+
+    template< class Char >
+    const typename Interned_string< Char >::String_type& Interned_string< Char >::empty_str()
+    {
+        static const String_type empty;
+
+        return empty;
+    }
+}
+
+#endif
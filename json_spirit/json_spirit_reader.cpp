@@ -4,28 +4,78 @@
 // json spirit version 4.02
 
 #include "json_spirit_reader.h"
+#include "json_spirit_reader_template.h"
 #include "json_spirit_value.h"
-
-//#define BOOST_SPIRIT_THREADSAFE  // uncomment for multithreaded use, requires linking to boost.thead
+#include "json_spirit_structural_index.h"
+#include "json_spirit_number.h"
+
+//#define JSON_SPIRIT_USE_SPIRIT_GRAMMER  // uncomment to parse with the original Spirit grammer rather than 
+                                          // the faster hand-written parser, both produce the same values
+
+//#define BOOST_SPIRIT_THREADSAFE  // uncomment for multithreaded use of the Spirit grammer, requires linking
+                                   // to boost.thread, the hand-written parser is always safe to use from
+                                   // several threads as each read keeps its state in its own local variables
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <cwctype>
+#include <iterator>
+#include <map>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
 
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
+#include <boost/iterator/iterator_facade.hpp>
 #include <boost/version.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/type_traits/is_same.hpp>
 
 #if BOOST_VERSION >= 103800
     #include <boost/spirit/include/classic_core.hpp>
     #include <boost/spirit/include/classic_confix.hpp>
     #include <boost/spirit/include/classic_escape_char.hpp>
-    #include <boost/spirit/include/classic_multi_pass.hpp>
-    #include <boost/spirit/include/classic_position_iterator.hpp>
+    #include <boost/spirit/include/classic_functor_parser.hpp>
     using namespace boost::spirit::classic;
+    namespace spirit_namespace = boost::spirit::classic;
 #else
     #include <boost/spirit/core.hpp>
     #include <boost/spirit/utility/confix.hpp>
     #include <boost/spirit/utility/escape_char.hpp>
-    #include <boost/spirit/iterator/multi_pass.hpp>
-    #include <boost/spirit/iterator/position_iterator.hpp>
+    #include <boost/spirit/utility/functor_parser.hpp>
     using namespace boost::spirit;
+    namespace spirit_namespace = boost::spirit;
+#endif
+
+// read_lines() and read_in_parallel() parse on several threads when the standard thread library is 
+// available, the Spirit grammer can only be used by several threads at once if BOOST_SPIRIT_THREADSAFE
+// is defined, read_in_parallel() needs the hand-written parser
+
+#if !defined( BOOST_NO_CXX11_HDR_THREAD ) && !defined( BOOST_NO_CXX11_HDR_MUTEX ) && \
+    !defined( BOOST_NO_CXX11_HDR_CONDITION_VARIABLE ) && \
+    ( !defined( JSON_SPIRIT_USE_SPIRIT_GRAMMER ) || defined( BOOST_SPIRIT_THREADSAFE ) )
+    #define JSON_SPIRIT_READ_IN_PARALLEL
+    #include <condition_variable>
+    #include <exception>
+    #include <mutex>
+    #include <thread>
 #endif
 
 using namespace json_spirit;
@@ -60,335 +110,41 @@ bool Error_position::operator==( const Error_position& lhs ) const
 
 namespace
 {
-    const int_parser < int64_t >  int64_p  = int_parser < int64_t  >();
-    const uint_parser< uint64_t > uint64_p = uint_parser< uint64_t >();
-
-    template< class Iter_type >
-    bool is_eq( Iter_type first, Iter_type last, const char* c_str )
-    {
-        for( Iter_type i = first; i != last; ++i, ++c_str )
-        {
-            if( *c_str == 0 ) return false;
-
-            if( *i != *c_str ) return false;
-        }
-
-        return true;
-    }
-
-    template< class Char_type >
-    Char_type hex_to_num( const Char_type c )
-    {
-        if( ( c >= '0' ) && ( c <= '9' ) ) return c - '0';
-        if( ( c >= 'a' ) && ( c <= 'f' ) ) return c - 'a' + 10;
-        if( ( c >= 'A' ) && ( c <= 'F' ) ) return c - 'A' + 10;
-        return 0;
-    }
-
-    template< class Char_type, class Iter_type >
-    Char_type hex_str_to_char( Iter_type& begin )
-    {
-        const Char_type c1( *( ++begin ) );
-        const Char_type c2( *( ++begin ) );
-
-        return ( hex_to_num( c1 ) << 4 ) + hex_to_num( c2 );
-    }       
-
-    template< class Char_type, class Iter_type >
-    Char_type unicode_str_to_char( Iter_type& begin )
-    {
-        const Char_type c1( *( ++begin ) );
-        const Char_type c2( *( ++begin ) );
-        const Char_type c3( *( ++begin ) );
-        const Char_type c4( *( ++begin ) );
-
-        return ( hex_to_num( c1 ) << 12 ) + 
-               ( hex_to_num( c2 ) <<  8 ) + 
-               ( hex_to_num( c3 ) <<  4 ) + 
-               hex_to_num( c4 );
-    }
-
-    template< class String_type >
-    void append_esc_char_and_incr_iter( String_type& s, 
-                                        typename String_type::const_iterator& begin, 
-                                        typename String_type::const_iterator end )
-    {
-        typedef typename String_type::value_type Char_type;
-             
-        const Char_type c2( *begin );
-
-        switch( c2 )
-        {
-            case 't':  s += '\t'; break;
-            case 'b':  s += '\b'; break;
-            case 'f':  s += '\f'; break;
-            case 'n':  s += '\n'; break;
-            case 'r':  s += '\r'; break;
-            case '\\': s += '\\'; break;
-            case '/':  s += '/';  break;
-            case '"':  s += '"';  break;
-            case 'x':  
-            {
-                if( end - begin >= 3 )  //  expecting "xHH..."
-                {
-                    s += hex_str_to_char< Char_type >( begin );  
-                }
-                break;
-            }
-            case 'u':  
-            {
-                if( end - begin >= 5 )  //  expecting "uHHHH..."
-                {
-                    s += unicode_str_to_char< Char_type >( begin );  
-                }
-                break;
-            }
-        }
-    }
-
-    template< class String_type >
-    String_type substitute_esc_chars( typename String_type::const_iterator begin, 
-                                   typename String_type::const_iterator end )
-    {
-        typedef typename String_type::const_iterator Iter_type;
-
-        if( end - begin < 2 ) return String_type( begin, end );
-
-        String_type result;
-        
-        result.reserve( end - begin );
-
-        const Iter_type end_minus_1( end - 1 );
-
-        Iter_type substr_start = begin;
-        Iter_type i = begin;
-
-        for( ; i < end_minus_1; ++i )
-        {
-            if( *i == '\\' )
-            {
-                result.append( substr_start, i );
-
-                ++i;  // skip the '\'
-             
-                append_esc_char_and_incr_iter( result, i, end );
-
-                substr_start = i + 1;
-            }
-        }
-
-        result.append( substr_start, end );
+    using internal_::is_eq;
+    using internal_::get_str;
+    using internal_::get_error_position;
+    using internal_::Json_parser;
+    using internal_::Semantic_actions;
 
-        return result;
-    }
-
-    template< class String_type >
-    String_type get_str_( typename String_type::const_iterator begin, 
-                       typename String_type::const_iterator end )
-    {
-        assert( end - begin >= 2 );
-
-        typedef typename String_type::const_iterator Iter_type;
-
-        Iter_type str_without_quotes( ++begin );
-        Iter_type end_without_quotes( --end );
-
-        return substitute_esc_chars< String_type >( str_without_quotes, end_without_quotes );
-    }
-
-    string get_str( string::const_iterator begin, string::const_iterator end )
-    {
-        return get_str_< string >( begin, end );
-    }
+    template< class Istream_type >
+    class Stream_chunk_iter;
 
-    wstring get_str( wstring::const_iterator begin, wstring::const_iterator end )
-    {
-        return get_str_< wstring >( begin, end );
-    }
-    
-    template< class String_type, class Iter_type >
-    String_type get_str( Iter_type begin, Iter_type end )
+    template< class String_type, class Istream_type >
+    String_type decode_str( Stream_chunk_iter< Istream_type > begin, Stream_chunk_iter< Istream_type > end, boost::true_type )
     {
-        const String_type tmp( begin, end );  // convert multipass iterators to string iterators
-
-        return get_str( tmp.begin(), tmp.end() );
+        return internal_::get_str_< String_type >( begin.ptr(), end.ptr() );  // the characters read from a stream are contiguous
     }
 
-    // this class's methods get called by the spirit parse resulting
-    // in the creation of a JSON object or array
+    // the Spirit grammer reports errors by throwing one of these, 
+    // the position is converted to a line and column by get_error_position
     //
-    // NB Iter_type could be a std::string iterator, wstring iterator, a position iterator or a multipass iterator
-    //
-    template< class Value_type, class Iter_type >
-    class Semantic_actions 
+    template< typename Iter_type >
+    struct Parse_failure
     {
-    public:
-
-        typedef typename Value_type::Config_type Config_type;
-        typedef typename Config_type::String_type String_type;
-        typedef typename Config_type::Object_type Object_type;
-        typedef typename Config_type::Array_type Array_type;
-        typedef typename String_type::value_type Char_type;
-
-        Semantic_actions( Value_type& value )
-        :   value_( value )
-        ,   current_p_( 0 )
-        {
-        }
-
-        void begin_obj( Char_type c )
-        {
-            assert( c == '{' );
-
-            begin_compound< Object_type >();
-        }
-
-        void end_obj( Char_type c )
-        {
-            assert( c == '}' );
-
-            end_compound();
-        }
-
-        void begin_array( Char_type c )
-        {
-            assert( c == '[' );
-     
-            begin_compound< Array_type >();
-        }
-
-        void end_array( Char_type c )
-        {
-            assert( c == ']' );
-
-            end_compound();
-        }
-
-        void new_name( Iter_type begin, Iter_type end )
-        {
-            assert( current_p_->type() == obj_type );
-
-            name_ = get_str< String_type >( begin, end );
-        }
-
-        void new_str( Iter_type begin, Iter_type end )
-        {
-            add_to_current( get_str< String_type >( begin, end ) );
-        }
-
-        void new_true( Iter_type begin, Iter_type end )
-        {
-            assert( is_eq( begin, end, "true" ) );
-
-            add_to_current( true );
-        }
-
-        void new_false( Iter_type begin, Iter_type end )
-        {
-            assert( is_eq( begin, end, "false" ) );
-
-            add_to_current( false );
-        }
-
-        void new_null( Iter_type begin, Iter_type end )
-        {
-            assert( is_eq( begin, end, "null" ) );
-
-            add_to_current( Value_type() );
-        }
-
-        void new_int( int64_t i )
-        {
-            add_to_current( i );
-        }
-
-        void new_uint64( uint64_t ui )
-        {
-            add_to_current( ui );
-        }
-
-        void new_real( double d )
-        {
-            add_to_current( d );
-        }
-
-    private:
-
-        Semantic_actions& operator=( const Semantic_actions& ); 
-                                    // to prevent "assignment operator could not be generated" warning
-
-        Value_type* add_first( const Value_type& value )
-        {
-            assert( current_p_ == 0 );
-
-            value_ = value;
-            current_p_ = &value_;
-            return current_p_;
-        }
-
-        template< class Array_or_obj >
-        void begin_compound()
-        {
-            if( current_p_ == 0 )
-            {
-                add_first( Array_or_obj() );
-            }
-            else
-            {
-                stack_.push_back( current_p_ );
-
-                Array_or_obj new_array_or_obj;   // avoid copy by building new array or object in place
-
-                current_p_ = add_to_current( new_array_or_obj );
-            }
-        }
-
-        void end_compound()
-        {
-            if( current_p_ != &value_ )
-            {
-                current_p_ = stack_.back();
-                
-                stack_.pop_back();
-            }    
-        }
-
-        Value_type* add_to_current( const Value_type& value )
+        Parse_failure( Iter_type posn, const char* reason )
+        :   posn_( posn )
+        ,   reason_( reason )
         {
-            if( current_p_ == 0 )
-            {
-                return add_first( value );
-            }
-            else if( current_p_->type() == array_type )
-            {
-                current_p_->get_array().push_back( value );
-
-                return &current_p_->get_array().back(); 
-            }
-            
-            assert( current_p_->type() == obj_type );
-
-            return &Config_type::add( current_p_->get_obj(), name_, value );
         }
 
-        Value_type& value_;             // this is the object or array that is being created
-        Value_type* current_p_;         // the child object or array that is currently being constructed
-
-        vector< Value_type* > stack_;   // previous child objects and arrays
-
-        String_type name_;              // of current name/value pair
+        Iter_type posn_;
+        const char* reason_;
     };
 
     template< typename Iter_type >
-    void throw_error( position_iterator< Iter_type > i, const std::string& reason )
-    {
-        throw Error_position( i.get_position().line, i.get_position().column, reason );
-    }
-
-    template< typename Iter_type >
-    void throw_error( Iter_type i, const std::string& reason )
+    void throw_error( Iter_type i, const char* reason )
     {
-       throw reason;
+        throw Parse_failure< Iter_type >( i, reason );
     }
 
     // the spirit grammer 
@@ -447,11 +203,11 @@ namespace
                 // first we convert the semantic action class methods to functors with the 
                 // parameter signature expected by spirit
 
-                typedef function< void( Char_type )            > Char_action;
-                typedef function< void( Iter_type, Iter_type ) > Str_action;
-                typedef function< void( double )               > Real_action;
-                typedef function< void( int64_t )              > Int_action;
-                typedef function< void( uint64_t )             > Uint64_action;
+                typedef boost::function< void( Char_type )            > Char_action;
+                typedef boost::function< void( Iter_type, Iter_type ) > Str_action;
+                typedef boost::function< void( double )               > Real_action;
+                typedef boost::function< void( int64_t )              > Int_action;
+                typedef boost::function< void( uint64_t )             > Uint64_action;
 
                 Char_action   begin_obj  ( bind( &Semantic_actions_t::begin_obj,   &self.actions_, _1 ) );
                 Char_action   end_obj    ( bind( &Semantic_actions_t::end_obj,     &self.actions_, _1 ) );
@@ -521,9 +277,7 @@ namespace
                     ;
 
                 number_
-                    = strict_real_p[ new_real   ] 
-                    | int64_p      [ new_int    ]
-                    | uint64_p     [ new_uint64 ]
+                    = functor_parser< Number_parser >( Number_parser( self.actions_ ) )
                     ;
             }
 
@@ -536,227 +290,2196 @@ namespace
 
         Json_grammer& operator=( const Json_grammer& ); // to prevent "assignment operator could not be generated" warning
 
+        // numbers are scanned by the same function as in Json_parser, rather than by trying 
+        // Spirit's real, int64 and uint64 parsers in turn
+
+        class Number_parser
+        {
+        public:
+
+            typedef nil_t result_t;
+
+            explicit Number_parser( Semantic_actions_t& actions )
+            :   actions_( &actions )
+            {
+            }
+
+            template< typename ScannerT >
+            std::ptrdiff_t operator()( const ScannerT& scan, result_t& ) const
+            {
+                scan.skip( scan );
+
+                internal_::Number number;
+
+                const typename ScannerT::iterator_t end = internal_::scan_number( scan.first, scan.last, number );
+
+                if( number.type_ == internal_::Number::none ) return -1;
+
+                const std::ptrdiff_t length = std::distance( scan.first, end );
+
+                scan.first = end;
+
+                actions_->new_number( number );
+
+                return length;
+            }
+
+        private:
+
+            Semantic_actions_t* actions_;
+        };
+
         Semantic_actions_t& actions_;
     };
 
+    // parses the value in [begin, end) without throwing, on success stop is set to the first character 
+    // after the value, on failure it is set to the position of the error and reason to its description
+    //
     template< class Iter_type, class Value_type >
-    Iter_type read_range_or_throw( Iter_type begin, Iter_type end, Value_type& value )
+    bool parse_range( Iter_type begin, Iter_type end, Value_type& value, Iter_type& stop, const char*& reason )
     {
         Semantic_actions< Value_type, Iter_type > semantic_actions( value );
      
-        const parse_info< Iter_type > info = parse( begin, end, 
-                                                    Json_grammer< Value_type, Iter_type >( semantic_actions ), 
-                                                    space_p );
+#ifdef JSON_SPIRIT_USE_SPIRIT_GRAMMER
+        try
+        {
+            const parse_info< Iter_type > info = parse( begin, end, 
+                                                        Json_grammer< Value_type, Iter_type >( semantic_actions ), 
+                                                        space_p );
+
+            assert( info.hit ); // in theory exception should already have been thrown
 
-        if( !info.hit )
+            stop = info.stop;
+
+            if( !info.hit ) reason = "error";
+
+            return info.hit;
+        }
+        catch( const Parse_failure< Iter_type >& failure )
         {
-            assert( false ); // in theory exception should already have been thrown
-            throw_error( info.stop, "error" );
+            stop   = failure.posn_;
+            reason = failure.reason_;
+
+            return false;
         }
+#else
+        Json_parser< Semantic_actions< Value_type, Iter_type >, Iter_type > parser( semantic_actions, begin, end );
 
-        return info.stop;
-    }
+        const bool ok = parser.parse();
 
-    template< class Iter_type, class Value_type >
-    void add_posn_iter_and_read_range_or_throw( Iter_type begin, Iter_type end, Value_type& value )
-    {
-        typedef position_iterator< Iter_type > Posn_iter_t;
+        stop   = parser.posn();
+        reason = parser.error_reason();
 
-        const Posn_iter_t posn_begin( begin, end );
-        const Posn_iter_t posn_end( end, end );
-     
-        read_range_or_throw( posn_begin, posn_end, value );
+        return ok;
+#endif
     }
 
+    // on success begin is advanced to the first character after the value, 
+    // on failure the position of the error is stored in error if it is not null
+    //
     template< class Iter_type, class Value_type >
-    bool read_range( Iter_type& begin, Iter_type end, Value_type& value )
+    bool read_range( Iter_type& begin, Iter_type end, Value_type& value, Error_position* error = 0 )
     {
-        try
-        {
-            begin = read_range_or_throw( begin, end, value );
+        Iter_type stop;
+        const char* reason = 0;
 
-            return true;
-        }
-        catch( ... )
+        if( !parse_range( begin, end, value, stop, reason ) )
         {
+            if( error != 0 ) *error = get_error_position( begin, end, stop, reason );
+
             return false;
         }
+
+        begin = stop;
+
+        return true;
     }
 
-    template< class String_type, class Value_type >
-    void read_string_or_throw( const String_type& s, Value_type& value )
+    template< class Iter_type, class Value_type >
+    void read_range_or_throw( Iter_type& begin, Iter_type end, Value_type& value )
     {
-        add_posn_iter_and_read_range_or_throw( s.begin(), s.end(), value );
+        Error_position error;
+
+        if( !read_range( begin, end, value, &error ) ) throw error;
     }
 
     template< class String_type, class Value_type >
-    bool read_string( const String_type& s, Value_type& value )
+    bool read_string( const String_type& s, Value_type& value, Error_position* error = 0 )
     {
         typename String_type::const_iterator begin = s.begin();
 
-        return read_range( begin, s.end(), value );
+        return read_range( begin, s.end(), value, error );
+    }
+
+    template< class String_type, class Value_type >
+    void read_string_or_throw( const String_type& s, Value_type& value )
+    {
+        Error_position error;
+
+        if( !read_string( s, value, &error ) ) throw error;
     }
 
+    // The characters of a stream that have been read so far. They are taken from the stream 
+    // buffer a block at a time with sgetn(), only when the parser reaches the end of those 
+    // already read, and are kept until the read is over as the parser may go back to any of them.
+    //
+    // No block is larger than what the stream buffer already holds, so the characters read 
+    // beyond the end of the value can be put back, leaving the stream just after the value.
+    //
     template< class Istream_type >
-    struct Multi_pass_iters
+    class Stream_chunks
     {
-        typedef typename Istream_type::char_type Char_type;
-        typedef istream_iterator< Char_type, Char_type > istream_iter;
-        typedef multi_pass< istream_iter > multi_pass_iter;
+    public:
+
+        typedef typename Istream_type::char_type   Char_type;
+        typedef typename Istream_type::traits_type Traits_type;
+        typedef typename basic_string< Char_type >::size_type Size_type;
 
-        Multi_pass_iters( Istream_type& is )
+        explicit Stream_chunks( Istream_type& is )
+        :   is_( is )
+        ,   sentry_( is, true )
+        ,   at_eof_( !sentry_ )
+        ,   next_chunk_size_( min_chunk_size )
         {
-            is.unsetf( ios::skipws );
+        }
 
-            begin_ = make_multi_pass( istream_iter( is ) );
-            end_   = make_multi_pass( istream_iter() );
+        const Char_type* data() const
+        {
+            return chars_.data();
         }
 
-        multi_pass_iter begin_;
-        multi_pass_iter end_;
-    };
+        Size_type size() const
+        {
+            return chars_.size();
+        }
 
-    template< class Istream_type, class Value_type >
-    bool read_stream( Istream_type& is, Value_type& value )
-    {
-        Multi_pass_iters< Istream_type > mp_iters( is );
+        // appends the next block of the stream, returns false at the end of the stream
+        //
+        BOOST_NOINLINE bool read_chunk()
+        {
+            if( at_eof_ ) return false;
 
-        return read_range( mp_iters.begin_, mp_iters.end_, value );
-    }
+            typename Istream_type::int_type c = is_.rdbuf()->sgetc();  // fills the stream buffer if it is empty
 
-    template< class Istream_type, class Value_type >
-    void read_stream_or_throw( Istream_type& is, Value_type& value )
-    {
-        const Multi_pass_iters< Istream_type > mp_iters( is );
+            if( Traits_type::eq_int_type( c, Traits_type::eof() ) )
+            {
+                at_eof_ = true;
 
-        add_posn_iter_and_read_range_or_throw( mp_iters.begin_, mp_iters.end_, value );
-    }
-}
+                is_.setstate( ios::eofbit );
 
-bool json_spirit::read( const std::string& s, Value& value )
-{
-    return read_string( s, value );
-}
+                return false;
+            }
 
-void json_spirit::read_or_throw( const std::string& s, Value& value )
-{
-    read_string_or_throw( s, value );
-}
+            streamsize nb_chars = is_.rdbuf()->in_avail();
 
-bool json_spirit::read( std::istream& is, Value& value )
-{
-    return read_stream( is, value );
-}
+            if( nb_chars <= 0 ) nb_chars = 1;  // an unbuffered stream
 
-void json_spirit::read_or_throw( std::istream& is, Value& value )
-{
-    read_stream_or_throw( is, value );
-}
+            if( nb_chars > next_chunk_size_ ) nb_chars = next_chunk_size_;
 
-bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, Value& value )
-{
-    return read_range( begin, end, value );
-}
+            if( next_chunk_size_ < max_chunk_size ) next_chunk_size_ *= 2;
 
-void json_spirit::read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, Value& value )
-{
-    begin = read_range_or_throw( begin, end, value );
-}
+            const Size_type old_size = chars_.size();
 
-#ifndef BOOST_NO_STD_WSTRING
+            chars_.resize( old_size + static_cast< Size_type >( nb_chars ) );
 
-bool json_spirit::read( const std::wstring& s, wValue& value )
-{
-    return read_string( s, value );
-}
+            nb_chars = is_.rdbuf()->sgetn( &chars_[ old_size ], nb_chars );
 
-void json_spirit::read_or_throw( const std::wstring& s, wValue& value )
-{
-    read_string_or_throw( s, value );
-}
+            chars_.resize( old_size + static_cast< Size_type >( nb_chars ) );
 
-bool json_spirit::read( std::wistream& is, wValue& value )
-{
+            return nb_chars > 0;
+        }
+
+        // returns the characters after posn to the stream, those the 
+        // stream buffer cannot take back are lost
+        //
+        void unread( Size_type posn )
+        {
+            for( Size_type i = chars_.size(); i > posn; --i )
+            {
+                if( Traits_type::eq_int_type( is_.rdbuf()->sputbackc( chars_[ i - 1 ] ), Traits_type::eof() ) ) break;
+            }
+        }
+
+    private:
+
+        Stream_chunks( const Stream_chunks& );
+        Stream_chunks& operator=( const Stream_chunks& );
+
+        static const streamsize min_chunk_size = 256;  // small, as a stream may hold a sequence of short values
+        static const streamsize max_chunk_size = 64 * 1024;
+
+        Istream_type& is_;
+        const typename Istream_type::sentry sentry_;
+        bool at_eof_;
+        streamsize next_chunk_size_;
+        basic_string< Char_type > chars_;
+    };
+
+    // refers to a character of Stream_chunks by its offset, so stays valid as more are read,
+    // a default constructed iterator is the end of the stream
+    //
+    template< class Istream_type >
+    class Stream_chunk_iter 
+        : public boost::iterator_facade< Stream_chunk_iter< Istream_type >, 
+                                         const typename Istream_type::char_type, 
+                                         boost::random_access_traversal_tag >
+    {
+    public:
+
+        typedef Stream_chunks< Istream_type > Chunks_type;
+        typedef typename Chunks_type::Char_type Char_type;
+        typedef typename Chunks_type::Size_type Size_type;
+
+        Stream_chunk_iter()
+        :   chunks_( 0 )
+        ,   i_( 0 )
+        {
+        }
+
+        Stream_chunk_iter( Chunks_type& chunks, Size_type i )
+        :   chunks_( &chunks )
+        ,   i_( i )
+        {
+        }
+
+        const Char_type* ptr() const
+        {
+            return chunks_->data() + i_;
+        }
+
+        Size_type offset() const
+        {
+            return i_;
+        }
+
+    private:
+
+        friend class boost::iterator_core_access;
+
+        bool is_end() const
+        {
+            return chunks_ == 0;
+        }
+
+        bool at_end_of_stream() const
+        {
+            return i_ == chunks_->size() && !chunks_->read_chunk();
+        }
+
+        const Char_type& dereference() const
+        {
+            return chunks_->data()[ i_ ];
+        }
+
+        bool equal( const Stream_chunk_iter& other ) const
+        {
+            if( other.is_end() ) return is_end() || at_end_of_stream();
+
+            if( is_end() ) return other.at_end_of_stream();
+
+            return i_ == other.i_;
+        }
+
+        void increment()
+        {
+            ++i_;
+        }
+
+        void decrement()
+        {
+            --i_;
+        }
+
+        void advance( std::ptrdiff_t n )
+        {
+            i_ += n;
+        }
+
+        std::ptrdiff_t distance_to( const Stream_chunk_iter& other ) const
+        {
+            assert( !is_end() && !other.is_end() );
+
+            return static_cast< std::ptrdiff_t >( other.i_ ) - static_cast< std::ptrdiff_t >( i_ );
+        }
+
+        Chunks_type* chunks_;
+        Size_type i_;
+    };
+
+    // on success the stream is left at the first character after the value
+    //
+    template< class Istream_type, class Value_type >
+    bool read_stream( Istream_type& is, Value_type& value, Error_position* error = 0 )
+    {
+        typedef Stream_chunk_iter< Istream_type > Iter_type;
+
+        Stream_chunks< Istream_type > chunks( is );
+
+        Iter_type begin( chunks, 0 );
+
+        if( !read_range( begin, Iter_type(), value, error ) ) return false;
+
+        chunks.unread( begin.offset() );
+
+        return true;
+    }
+
+    template< class Istream_type, class Value_type >
+    void read_stream_or_throw( Istream_type& is, Value_type& value )
+    {
+        Error_position error;
+
+        if( !read_stream( is, value, &error ) ) throw error;
+    }
+
+    // The text of a file. Files of at least min_mapped_size bytes are mapped into memory and 
+    // parsed where they are, smaller ones are read into a string as mapping them saves nothing.
+    // Anything that cannot be mapped, eg. a pipe, is also read into the string.
+    //
+    class File_contents
+    {
+    public:
+
+        static const string::size_type min_mapped_size = 64 * 1024;
+
+        explicit File_contents( const string& path )
+        :   begin_( 0 )
+        ,   end_( 0 )
+        ,   is_open_( false )
+        ,   is_mapped_( false )
+        {
+            is_open_ = map_or_read( path );
+
+            if( is_open_ && !is_mapped_ )
+            {
+                begin_ = text_.data();
+                end_   = begin_ + text_.size();
+            }
+        }
+
+        ~File_contents()
+        {
+            if( !is_mapped_ ) return;
+#ifdef _WIN32
+            UnmapViewOfFile( begin_ );
+#else
+            munmap( const_cast< char* >( begin_ ), size() );
+#endif
+        }
+
+        bool is_open() const
+        {
+            return is_open_;
+        }
+
+        const char* begin() const
+        {
+            return begin_;
+        }
+
+        const char* end() const
+        {
+            return end_;
+        }
+
+        string::size_type size() const
+        {
+            return static_cast< string::size_type >( end_ - begin_ );
+        }
+
+    private:
+
+        File_contents( const File_contents& );
+        File_contents& operator=( const File_contents& );
+
+#ifdef _WIN32
+        bool map_or_read( const string& path )
+        {
+            const HANDLE file = CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, 
+                                             OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, 0 );
+
+            if( file == INVALID_HANDLE_VALUE ) return false;
+
+            LARGE_INTEGER size;
+
+            if( GetFileType( file ) == FILE_TYPE_DISK && GetFileSizeEx( file, &size ) &&
+                static_cast< boost::uint64_t >( size.QuadPart ) >= min_mapped_size &&
+                static_cast< boost::uint64_t >( size.QuadPart ) <= static_cast< SIZE_T >( -1 ) )
+            {
+                const HANDLE mapping = CreateFileMappingA( file, 0, PAGE_READONLY, 0, 0, 0 );
+
+                if( mapping != 0 )
+                {
+                    const void* view = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+
+                    CloseHandle( mapping );  // the view keeps the mapping open
+
+                    if( view != 0 )
+                    {
+                        begin_ = static_cast< const char* >( view );
+                        end_   = begin_ + static_cast< SIZE_T >( size.QuadPart );
+                        is_mapped_ = true;
+                    }
+                }
+            }
+
+            bool ok = true;
+
+            if( !is_mapped_ )
+            {
+                char buf[ 64 * 1024 ];
+                DWORD nb_read = 0;
+
+                while( ( ok = ReadFile( file, buf, sizeof( buf ), &nb_read, 0 ) != 0 ) && nb_read > 0 )
+                {
+                    text_.append( buf, nb_read );
+                }
+            }
+
+            CloseHandle( file );
+
+            return ok;
+        }
+#else
+        bool map_or_read( const string& path )
+        {
+            const int fd = ::open( path.c_str(), O_RDONLY );
+
+            if( fd < 0 ) return false;
+
+            struct stat st;
+
+            if( fstat( fd, &st ) == 0 && S_ISREG( st.st_mode ) &&
+                static_cast< boost::uint64_t >( st.st_size ) >= min_mapped_size &&
+                static_cast< boost::uint64_t >( st.st_size ) <= static_cast< size_t >( -1 ) )
+            {
+                const size_t size = static_cast< size_t >( st.st_size );
+
+                void* const addr = mmap( 0, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+                if( addr != MAP_FAILED )
+                {
+#ifdef MADV_SEQUENTIAL
+                    madvise( addr, size, MADV_SEQUENTIAL );
+#endif
+                    begin_ = static_cast< const char* >( addr );
+                    end_   = begin_ + size;
+                    is_mapped_ = true;
+                }
+            }
+
+            bool ok = true;
+
+            if( !is_mapped_ )
+            {
+                char buf[ 64 * 1024 ];
+                ssize_t nb_read = 0;
+
+                while( ( nb_read = ::read( fd, buf, sizeof( buf ) ) ) != 0 )
+                {
+                    if( nb_read < 0 )
+                    {
+                        if( errno == EINTR ) continue;
+
+                        ok = false;
+                        break;
+                    }
+
+                    text_.append( buf, static_cast< string::size_type >( nb_read ) );
+                }
+            }
+
+            ::close( fd );  // the mapping stays valid
+
+            return ok;
+        }
+#endif
+
+        const char* begin_;
+        const char* end_;
+        bool is_open_;
+        bool is_mapped_;
+        string text_;  // if not mapped
+    };
+
+    // a file that cannot be read is reported as an error at line and column 0
+    //
+    template< class Value_type >
+    bool read_mapped_file( const string& path, Value_type& value, Error_position* error = 0 )
+    {
+        const File_contents file( path );
+
+        if( !file.is_open() )
+        {
+            if( error != 0 ) *error = Error_position( 0, 0, "cannot read file" );
+
+            return false;
+        }
+
+        const char* begin = file.begin();
+
+        return read_range( begin, file.end(), value, error );
+    }
+
+    template< class Value_type >
+    void read_mapped_file_or_throw( const string& path, Value_type& value )
+    {
+        Error_position error;
+
+        if( !read_mapped_file( path, value, &error ) ) throw error;
+    }
+
+    // a line must hold a single value, optionally surrounded by white space
+    //
+    template< class Value_type >
+    bool read_line( const char* begin, const char* end, Value_type& value, Error_position& error )
+    {
+        const char* i = begin;
+
+        if( !read_range( i, end, value, &error ) ) return false;
+
+        while( i != end && internal_::is_space( *i ) ) ++i;
+
+        if( i == end ) return true;
+
+        error = internal_::get_error_position( begin, end, i, "extra text after the value" );
+
+        return false;
+    }
+
+    // Reads each line of [begin, end), which must start at the beginning of a line, and passes its 
+    // value to the handler. Lines are numbered from first_line. Returns false, with the error of the
+    // first malformed line, if any line could not be read.
+    //
+    template< class Value_type, class Handler_type >
+    bool read_lines_range( const char* begin, const char* end, size_t first_line, 
+                           Handler_type& handler, Error_position& error )
+    {
+        bool success = true;
+
+        for( size_t line = first_line; begin != end; ++line )
+        {
+            const char* line_end = static_cast< const char* >( memchr( begin, '\n', end - begin ) );
+
+            if( line_end == 0 ) line_end = end;
+
+            const char* i = begin;
+
+            while( i != line_end && internal_::is_space( *i ) ) ++i;
+
+            if( i != line_end )
+            {
+                Value_type value;
+                Error_position line_error;
+
+                if( read_line( begin, line_end, value, line_error ) )
+                {
+                    handler( line, value );
+                }
+                else if( success )
+                {
+                    success = false;
+                    error = line_error;
+                    error.line_ = static_cast< unsigned int >( line );
+                }
+            }
+
+            begin = line_end == end ? end : line_end + 1;
+        }
+
+        return success;
+    }
+
+#ifdef JSON_SPIRIT_READ_IN_PARALLEL
+
+    // Splits a document into chunks of whole lines that are claimed and read by a number of threads.
+    // A chunk is split off when a thread asks for one, so threads that finish their chunks early 
+    // take more of the remaining work. In line order, the values of each chunk are kept until
+    // the chunks before it have been passed to the callback. Threads stop claiming chunks when 
+    // they get too far ahead of the callback, which limits the number of values held.
+    //
+    template< class Value_type >
+    class Parallel_line_reader
+    {
+    public:
+
+        typedef typename Line_callback< Value_type >::type Callback_type;
+
+        Parallel_line_reader( const string& s, const Callback_type& callback, 
+                              unsigned int nb_threads, Line_order order )
+        :   callback_( callback )
+        ,   nb_threads_( nb_threads )
+        ,   order_( order )
+        ,   next_( s.data() )
+        ,   end_( s.data() + s.size() )
+        ,   next_line_( 1 )
+        ,   nb_chunks_( 0 )
+        ,   nb_chunks_delivered_( 0 )
+        ,   failed_( false )
+        ,   stopped_( false )
+        {
+        }
+
+        bool read( Error_position& error )
+        {
+            vector< std::thread > threads;
+
+            try
+            {
+                // in line order the calling thread passes the values to the callback, otherwise 
+                // it reads lines as well
+
+                const unsigned int nb_workers = order_ == lines_in_order ? nb_threads_ : nb_threads_ - 1;
+
+                for( unsigned int i = 0; i < nb_workers; ++i )
+                {
+                    threads.push_back( std::thread( &Parallel_line_reader::work, this ) );
+                }
+
+                if( order_ == lines_in_order )
+                {
+                    deliver_in_order();
+                }
+                else
+                {
+                    work();
+                }
+            }
+            catch( ... )
+            {
+                stop( std::current_exception() );
+            }
+
+            for( vector< std::thread >::iterator i = threads.begin(); i != threads.end(); ++i )
+            {
+                i->join();
+            }
+
+            if( exception_ ) std::rethrow_exception( exception_ );
+
+            if( failed_ ) error = error_;
+
+            return !failed_;
+        }
+
+    private:
+
+        typedef vector< pair< size_t, Value_type > > Values;
+
+        struct Chunk
+        {
+            const char* begin_;
+            const char* end_;
+            size_t first_line_;
+            size_t index_;
+        };
+
+        // keeps the values of a chunk to be passed to the callback later
+
+        struct Value_store
+        {
+            explicit Value_store( Values& values )
+            :   values_( values )
+            {
+            }
+
+            void operator()( size_t line, Value_type& value )
+            {
+                values_.push_back( make_pair( line, Value_type() ) );
+                values_.back().second = std::move( value );
+            }
+
+            Values& values_;
+        };
+
+        static const size_t chunk_size = 64 * 1024;
+        static const size_t max_chunks_ahead_per_thread = 4;
+
+        void work()
+        {
+            try
+            {
+                Chunk chunk;
+
+                while( claim_chunk( chunk ) )
+                {
+                    Error_position error;
+
+                    if( order_ == lines_in_order )
+                    {
+                        Values values;
+                        Value_store store( values );
+
+                        const bool success = read_lines_range< Value_type >( chunk.begin_, chunk.end_, chunk.first_line_, store, error );
+
+                        std::lock_guard< std::mutex > lock( mutex_ );
+
+                        values_[ chunk.index_ ].swap( values );
+
+                        if( !success ) note_error( error );
+
+                        changed_.notify_all();
+                    }
+                    else
+                    {
+                        if( !read_lines_range< Value_type >( chunk.begin_, chunk.end_, chunk.first_line_, callback_, error ) )
+                        {
+                            std::lock_guard< std::mutex > lock( mutex_ );
+
+                            note_error( error );
+                        }
+                    }
+                }
+            }
+            catch( ... )
+            {
+                stop( std::current_exception() );
+            }
+        }
+
+        bool claim_chunk( Chunk& chunk )
+        {
+            std::unique_lock< std::mutex > lock( mutex_ );
+
+            if( order_ == lines_in_order )
+            {
+                const size_t max_chunks_ahead = max_chunks_ahead_per_thread * nb_threads_;
+
+                while( !stopped_ && next_ != end_ && nb_chunks_ >= nb_chunks_delivered_ + max_chunks_ahead )
+                {
+                    changed_.wait( lock );
+                }
+            }
+
+            if( stopped_ || next_ == end_ ) return false;
+
+            const char* chunk_end = end_;
+
+            if( static_cast< size_t >( end_ - next_ ) > chunk_size )
+            {
+                chunk_end = static_cast< const char* >( memchr( next_ + chunk_size, '\n', end_ - next_ - chunk_size ) );
+
+                chunk_end = chunk_end == 0 ? end_ : chunk_end + 1;
+            }
+
+            chunk.begin_      = next_;
+            chunk.end_        = chunk_end;
+            chunk.first_line_ = next_line_;
+            chunk.index_      = nb_chunks_++;
+
+            next_line_ += count( chunk.begin_, chunk.end_, '\n' );
+            next_       = chunk.end_;
+
+            return true;
+        }
+
+        void deliver_in_order()
+        {
+            for( size_t i = 0; ; ++i )
+            {
+                Values values;
+
+                {
+                    std::unique_lock< std::mutex > lock( mutex_ );
+
+                    typename map< size_t, Values >::iterator chunk_values;
+
+                    while( !stopped_ && ( chunk_values = values_.find( i ) ) == values_.end() )
+                    {
+                        if( next_ == end_ && i == nb_chunks_ ) return;
+
+                        changed_.wait( lock );
+                    }
+
+                    if( stopped_ ) return;
+
+                    values.swap( chunk_values->second );
+                    values_.erase( chunk_values );
+
+                    ++nb_chunks_delivered_;
+
+                    changed_.notify_all();
+                }
+
+                for( typename Values::iterator j = values.begin(); j != values.end(); ++j )
+                {
+                    callback_( j->first, j->second );
+                }
+            }
+        }
+
+        // keeps the error on the earliest line, must be called with the mutex locked
+
+        void note_error( const Error_position& error )
+        {
+            if( failed_ && error_.line_ < error.line_ ) return;
+
+            failed_ = true;
+            error_  = error;
+        }
+
+        void stop( std::exception_ptr e )
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+
+            if( !exception_ ) exception_ = e;
+
+            stopped_ = true;
+
+            changed_.notify_all();
+        }
+
+        const Callback_type& callback_;
+        const unsigned int nb_threads_;
+        const Line_order order_;
+
+        std::mutex mutex_;  // guards all of the following
+        std::condition_variable changed_;
+        const char* next_;  // the start of the next chunk
+        const char* const end_;
+        size_t next_line_;
+        size_t nb_chunks_;
+        size_t nb_chunks_delivered_;
+        map< size_t, Values > values_;  // chunks that have been read but not delivered, by index
+        bool failed_;
+        Error_position error_;
+        bool stopped_;
+        std::exception_ptr exception_;
+    };
+
+#endif
+
+    template< class Value_type >
+    bool read_lines_string( const string& s, const typename Line_callback< Value_type >::type& callback, 
+                            Error_position& error, unsigned int nb_threads, Line_order order )
+    {
+#ifdef JSON_SPIRIT_READ_IN_PARALLEL
+        if( nb_threads == 0 ) nb_threads = std::thread::hardware_concurrency();
+
+        if( nb_threads > 1 )
+        {
+            return Parallel_line_reader< Value_type >( s, callback, nb_threads, order ).read( error );
+        }
+#else
+        (void)nb_threads;  // read on this thread, in order
+        (void)order;
+#endif
+
+        return read_lines_range< Value_type >( s.data(), s.data() + s.size(), 1, callback, error );
+    }
+
+#if defined( JSON_SPIRIT_READ_IN_PARALLEL ) && !defined( JSON_SPIRIT_USE_SPIRIT_GRAMMER )
+
+    // reads the comma separated values in [begin, end) as the elements of an array
+    //
+    template< class Value_type >
+    bool read_elements( const char* begin, const char* end, Value_type& array )
+    {
+        typedef Semantic_actions< Value_type, const char* > Actions_type;
+
+        Actions_type actions( array );
+
+        actions.begin_array( '[' );
+
+        for( const char* i = begin; ; ++i )
+        {
+            Json_parser< Actions_type, const char* > parser( actions, i, end );
+
+            if( !parser.parse() ) return false;
+
+            for( i = parser.posn(); i != end && internal_::is_space( *i ); ++i )
+            {
+            }
+
+            if( i == end ) break;
+
+            if( *i != ',' ) return false;
+        }
+
+        actions.end_array( ']' );
+
+        return true;
+    }
+
+    // Splits a document that is a single array into parts holding whole elements, which are claimed
+    // and read by a number of threads. The commas between the elements of the top level array are
+    // found by walking a structural index of the text, built a window at a time to keep it small, 
+    // while counting the depth of nesting.
+    //
+    // The index only describes the text correctly up to the first syntax error, so the split is 
+    // only known to be right once every part has been read. If any part cannot be read, read()
+    // returns false and the caller reads the document again on one thread to find the error.
+    //
+    template< class Value_type >
+    class Parallel_array_reader
+    {
+    public:
+
+        Parallel_array_reader( const char* begin, const char* end, unsigned int nb_threads )
+        :   begin_( begin )
+        ,   end_( end )
+        ,   nb_threads_( nb_threads )
+        ,   next_part_( 0 )
+        ,   failed_( false )
+        {
+        }
+
+        bool read( Value_type& value )
+        {
+            if( !split() ) return false;
+
+            values_.resize( parts_.size() );
+
+            vector< std::thread > threads;
+
+            try
+            {
+                for( unsigned int i = 1; i < nb_threads_; ++i )  // the calling thread reads parts as well
+                {
+                    threads.push_back( std::thread( &Parallel_array_reader::work, this ) );
+                }
+
+                work();
+            }
+            catch( ... )
+            {
+                stop( std::current_exception() );
+            }
+
+            for( vector< std::thread >::iterator i = threads.begin(); i != threads.end(); ++i )
+            {
+                i->join();
+            }
+
+            if( exception_ ) std::rethrow_exception( exception_ );
+
+            if( failed_ ) return false;
+
+            // the first part's array becomes the result, the elements of the others are moved onto its end
+
+            Array_type& elements = values_.front().get_array();
+
+            size_t nb_elements = 0;
+
+            for( typename vector< Value_type >::iterator i = values_.begin(); i != values_.end(); ++i )
+            {
+                nb_elements += i->get_array().size();
+            }
+
+            elements.reserve( nb_elements );
+
+            for( typename vector< Value_type >::iterator i = values_.begin() + 1; i != values_.end(); ++i )
+            {
+                Array_type& part = i->get_array();
+
+                std::move( part.begin(), part.end(), back_inserter( elements ) );
+            }
+
+            value = std::move( values_.front() );
+
+            return true;
+        }
+
+    private:
+
+        typedef typename Value_type::Array Array_type;
+        typedef pair< const char*, const char* > Part;
+
+        static const size_t parts_per_thread = 4;  // so that threads finishing early take more of the work
+        static const size_t min_part_size    = 64 * 1024;
+        static const size_t window_size      = 1024 * 1024;
+
+        // returns false if the document is not an array, or its end was not found
+
+        bool split()
+        {
+            const char* i = begin_;
+
+            while( i != end_ && internal_::is_space( *i ) ) ++i;
+
+            if( i == end_ || *i != '[' ) return false;
+
+            const size_t part_size = ( std::max )( ( end_ - i ) / ( nb_threads_ * parts_per_thread ), size_t( min_part_size ) );
+
+            const char* part_begin   = i + 1;
+            const char* window_begin = i + 1;  // always outside any string
+            unsigned int depth = 1;
+
+            internal_::Structural_index index;
+
+            while( window_begin != end_ )
+            {
+                const char* const window_end = static_cast< size_t >( end_ - window_begin ) > window_size ? window_begin + window_size : end_;
+
+                if( !index.build( window_begin, window_end ) ) return false;
+
+                const char* next_window_begin = window_begin;  // after the last character known to be outside strings
+
+                const internal_::Structural_index::Offsets& offsets = index.offsets();
+
+                for( internal_::Structural_index::Offsets::const_iterator j = offsets.begin(); j != offsets.end(); ++j )
+                {
+                    const char* const p = window_begin + *j;
+
+                    switch( *p )
+                    {
+                        case '"':
+                        case '\\':
+                            continue;
+
+                        case '[':
+                        case '{':
+                            ++depth;
+                            break;
+
+                        case ']':
+                        case '}':
+                            if( --depth == 0 )
+                            {
+                                if( *p != ']' ) return false;
+
+                                parts_.push_back( Part( part_begin, p ) );
+                                return true;
+                            }
+                            break;
+
+                        case ',':
+                            if( depth == 1 && static_cast< size_t >( p - part_begin ) >= part_size )
+                            {
+                                parts_.push_back( Part( part_begin, p ) );
+                                part_begin = p + 1;
+                            }
+                            break;
+                    }
+
+                    next_window_begin = p + 1;
+                }
+
+                // the window may end inside a string, so the next starts after the last bracket, brace, 
+                // colon or comma, a window without any is a string too long to be worth splitting around
+
+                if( window_end == end_ || next_window_begin == window_begin ) return false;
+
+                window_begin = next_window_begin;
+            }
+
+            return false;
+        }
+
+        void work()
+        {
+            try
+            {
+                size_t part;
+
+                while( claim_part( part ) )
+                {
+                    if( !read_elements( parts_[ part ].first, parts_[ part ].second, values_[ part ] ) )
+                    {
+                        std::lock_guard< std::mutex > lock( mutex_ );
+
+                        failed_ = true;
+                    }
+                }
+            }
+            catch( ... )
+            {
+                stop( std::current_exception() );
+            }
+        }
+
+        bool claim_part( size_t& part )
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+
+            if( failed_ || next_part_ == parts_.size() ) return false;
+
+            part = next_part_++;
+
+            return true;
+        }
+
+        void stop( std::exception_ptr e )
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+
+            if( !exception_ ) exception_ = e;
+
+            failed_ = true;
+        }
+
+        const char* const begin_;
+        const char* const end_;
+        const unsigned int nb_threads_;
+        vector< Part > parts_;
+        vector< Value_type > values_;  // the array read from each part, each written by one thread
+
+        std::mutex mutex_;  // guards all of the following
+        size_t next_part_;
+        bool failed_;
+        std::exception_ptr exception_;
+    };
+
+#endif
+
+    // documents smaller than this are read on one thread
+    //
+    const string::size_type min_parallel_size = 1024 * 1024;
+
+    template< class Value_type >
+    bool read_chars_in_parallel( const char* begin, const char* end, Value_type& value, Error_position* error, 
+                                 unsigned int nb_threads )
+    {
+#if defined( JSON_SPIRIT_READ_IN_PARALLEL ) && !defined( JSON_SPIRIT_USE_SPIRIT_GRAMMER )
+        if( nb_threads == 0 ) nb_threads = std::thread::hardware_concurrency();
+
+        if( nb_threads > 1 && static_cast< string::size_type >( end - begin ) >= min_parallel_size )
+        {
+            if( Parallel_array_reader< Value_type >( begin, end, nb_threads ).read( value ) ) return true;
+        }
+#else
+        (void)nb_threads;  // read on this thread
+#endif
+
+        return read_range( begin, end, value, error );  // also finds the error of a malformed document
+    }
+
+    template< class Value_type >
+    bool read_mapped_file_in_parallel( const string& path, Value_type& value, Error_position* error, 
+                                       unsigned int nb_threads )
+    {
+        const File_contents file( path );
+
+        if( !file.is_open() )
+        {
+            if( error != 0 ) *error = Error_position( 0, 0, "cannot read file" );
+
+            return false;
+        }
+
+        return read_chars_in_parallel( file.begin(), file.end(), value, error, nb_threads );
+    }
+}
+
+bool json_spirit::read( const std::string& s, Value& value )
+{
+    return read_string( s, value );
+}
+
+bool json_spirit::read( const std::string& s, Value& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::string& s, Value& value )
+{
+    read_string_or_throw( s, value );
+}
+
+bool json_spirit::read( std::istream& is, Value& value )
+{
+    return read_stream( is, value );
+}
+
+bool json_spirit::read( std::istream& is, Value& value, Error_position& error )
+{
+    return read_stream( is, value, &error );
+}
+
+void json_spirit::read_or_throw( std::istream& is, Value& value )
+{
+    read_stream_or_throw( is, value );
+}
+
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, Value& value )
+{
+    return read_range( begin, end, value );
+}
+
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, Value& value, Error_position& error )
+{
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, Value& value )
+{
+    read_range_or_throw( begin, end, value );
+}
+
+#ifndef BOOST_NO_STD_WSTRING
+
+bool json_spirit::read( const std::wstring& s, wValue& value )
+{
+    return read_string( s, value );
+}
+
+bool json_spirit::read( const std::wstring& s, wValue& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::wstring& s, wValue& value )
+{
+    read_string_or_throw( s, value );
+}
+
+bool json_spirit::read( std::wistream& is, wValue& value )
+{
+    return read_stream( is, value );
+}
+
+bool json_spirit::read( std::wistream& is, wValue& value, Error_position& error )
+{
+    return read_stream( is, value, &error );
+}
+
+void json_spirit::read_or_throw( std::wistream& is, wValue& value )
+{
+    read_stream_or_throw( is, value );
+}
+
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wValue& value )
+{
+    return read_range( begin, end, value );
+}
+
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wValue& value, Error_position& error )
+{
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wValue& value )
+{
+    read_range_or_throw( begin, end, value );
+}
+
+#endif
+
+bool json_spirit::read( const std::string& s, mValue& value )
+{
+    return read_string( s, value );
+}
+
+bool json_spirit::read( const std::string& s, mValue& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::string& s, mValue& value )
+{
+    read_string_or_throw( s, value );
+}
+
+bool json_spirit::read( std::istream& is, mValue& value )
+{
+    return read_stream( is, value );
+}
+
+bool json_spirit::read( std::istream& is, mValue& value, Error_position& error )
+{
+    return read_stream( is, value, &error );
+}
+
+void json_spirit::read_or_throw( std::istream& is, mValue& value )
+{
+    read_stream_or_throw( is, value );
+}
+
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, mValue& value )
+{
+    return read_range( begin, end, value );
+}
+
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, mValue& value, Error_position& error )
+{
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, mValue& value )
+{
+    read_range_or_throw( begin, end, value );
+}
+
+#ifndef BOOST_NO_STD_WSTRING
+
+bool json_spirit::read( const std::wstring& s, wmValue& value )
+{
+    return read_string( s, value );
+}
+
+bool json_spirit::read( const std::wstring& s, wmValue& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::wstring& s, wmValue& value )
+{
+    read_string_or_throw( s, value );
+}
+
+bool json_spirit::read( std::wistream& is, wmValue& value )
+{
+    return read_stream( is, value );
+}
+
+bool json_spirit::read( std::wistream& is, wmValue& value, Error_position& error )
+{
+    return read_stream( is, value, &error );
+}
+
+void json_spirit::read_or_throw( std::wistream& is, wmValue& value )
+{
+    read_stream_or_throw( is, value );
+}
+
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wmValue& value )
+{
+    return read_range( begin, end, value );
+}
+
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wmValue& value, Error_position& error )
+{
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wmValue& value )
+{
+    read_range_or_throw( begin, end, value );
+}
+
+#endif
+
+bool json_spirit::read( const std::string& s, cValue& value )
+{
+    return read_string( s, value );
+}
+
+bool json_spirit::read( const std::string& s, cValue& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::string& s, cValue& value )
+{
+    read_string_or_throw( s, value );
+}
+
+bool json_spirit::read( std::istream& is, cValue& value )
+{
+    return read_stream( is, value );
+}
+
+bool json_spirit::read( std::istream& is, cValue& value, Error_position& error )
+{
+    return read_stream( is, value, &error );
+}
+
+void json_spirit::read_or_throw( std::istream& is, cValue& value )
+{
+    read_stream_or_throw( is, value );
+}
+
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, cValue& value )
+{
+    return read_range( begin, end, value );
+}
+
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, cValue& value, Error_position& error )
+{
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, cValue& value )
+{
+    read_range_or_throw( begin, end, value );
+}
+
+#ifndef BOOST_NO_STD_WSTRING
+
+bool json_spirit::read( const std::wstring& s, wcValue& value )
+{
+    return read_string( s, value );
+}
+
+bool json_spirit::read( const std::wstring& s, wcValue& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::wstring& s, wcValue& value )
+{
+    read_string_or_throw( s, value );
+}
+
+bool json_spirit::read( std::wistream& is, wcValue& value )
+{
+    return read_stream( is, value );
+}
+
+bool json_spirit::read( std::wistream& is, wcValue& value, Error_position& error )
+{
+    return read_stream( is, value, &error );
+}
+
+void json_spirit::read_or_throw( std::wistream& is, wcValue& value )
+{
+    read_stream_or_throw( is, value );
+}
+
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wcValue& value )
+{
+    return read_range( begin, end, value );
+}
+
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wcValue& value, Error_position& error )
+{
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wcValue& value )
+{
+    read_range_or_throw( begin, end, value );
+}
+
+#endif
+
+bool json_spirit::read( const std::string& s, aValue& value )
+{
+    return read_string( s, value );
+}
+
+bool json_spirit::read( const std::string& s, aValue& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::string& s, aValue& value )
+{
+    read_string_or_throw( s, value );
+}
+
+bool json_spirit::read( std::istream& is, aValue& value )
+{
+    return read_stream( is, value );
+}
+
+bool json_spirit::read( std::istream& is, aValue& value, Error_position& error )
+{
+    return read_stream( is, value, &error );
+}
+
+void json_spirit::read_or_throw( std::istream& is, aValue& value )
+{
+    read_stream_or_throw( is, value );
+}
+
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, aValue& value )
+{
+    return read_range( begin, end, value );
+}
+
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, aValue& value, Error_position& error )
+{
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, aValue& value )
+{
+    read_range_or_throw( begin, end, value );
+}
+
+#ifndef BOOST_NO_STD_WSTRING
+
+bool json_spirit::read( const std::wstring& s, waValue& value )
+{
+    return read_string( s, value );
+}
+
+bool json_spirit::read( const std::wstring& s, waValue& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::wstring& s, waValue& value )
+{
+    read_string_or_throw( s, value );
+}
+
+bool json_spirit::read( std::wistream& is, waValue& value )
+{
+    return read_stream( is, value );
+}
+
+bool json_spirit::read( std::wistream& is, waValue& value, Error_position& error )
+{
+    return read_stream( is, value, &error );
+}
+
+void json_spirit::read_or_throw( std::wistream& is, waValue& value )
+{
+    read_stream_or_throw( is, value );
+}
+
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, waValue& value )
+{
+    return read_range( begin, end, value );
+}
+
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, waValue& value, Error_position& error )
+{
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, waValue& value )
+{
+    read_range_or_throw( begin, end, value );
+}
+
+#endif
+
+bool json_spirit::read( const std::string& s, amValue& value )
+{
+    return read_string( s, value );
+}
+
+bool json_spirit::read( const std::string& s, amValue& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::string& s, amValue& value )
+{
+    read_string_or_throw( s, value );
+}
+
+bool json_spirit::read( std::istream& is, amValue& value )
+{
+    return read_stream( is, value );
+}
+
+bool json_spirit::read( std::istream& is, amValue& value, Error_position& error )
+{
+    return read_stream( is, value, &error );
+}
+
+void json_spirit::read_or_throw( std::istream& is, amValue& value )
+{
+    read_stream_or_throw( is, value );
+}
+
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, amValue& value )
+{
+    return read_range( begin, end, value );
+}
+
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, amValue& value, Error_position& error )
+{
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, amValue& value )
+{
+    read_range_or_throw( begin, end, value );
+}
+
+#ifndef BOOST_NO_STD_WSTRING
+
+bool json_spirit::read( const std::wstring& s, wamValue& value )
+{
+    return read_string( s, value );
+}
+
+bool json_spirit::read( const std::wstring& s, wamValue& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::wstring& s, wamValue& value )
+{
+    read_string_or_throw( s, value );
+}
+
+bool json_spirit::read( std::wistream& is, wamValue& value )
+{
+    return read_stream( is, value );
+}
+
+bool json_spirit::read( std::wistream& is, wamValue& value, Error_position& error )
+{
+    return read_stream( is, value, &error );
+}
+
+void json_spirit::read_or_throw( std::wistream& is, wamValue& value )
+{
+    read_stream_or_throw( is, value );
+}
+
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wamValue& value )
+{
+    return read_range( begin, end, value );
+}
+
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wamValue& value, Error_position& error )
+{
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wamValue& value )
+{
+    read_range_or_throw( begin, end, value );
+}
+
+#endif
+
+bool json_spirit::read_file( const std::string& path, Value& value )
+{
+    return read_mapped_file( path, value );
+}
+
+bool json_spirit::read_file( const std::string& path, Value& value, Error_position& error )
+{
+    return read_mapped_file( path, value, &error );
+}
+
+void json_spirit::read_file_or_throw( const std::string& path, Value& value )
+{
+    read_mapped_file_or_throw( path, value );
+}
+
+bool json_spirit::read_file( const std::string& path, mValue& value )
+{
+    return read_mapped_file( path, value );
+}
+
+bool json_spirit::read_file( const std::string& path, mValue& value, Error_position& error )
+{
+    return read_mapped_file( path, value, &error );
+}
+
+void json_spirit::read_file_or_throw( const std::string& path, mValue& value )
+{
+    read_mapped_file_or_throw( path, value );
+}
+
+bool json_spirit::read_file( const std::string& path, cValue& value )
+{
+    return read_mapped_file( path, value );
+}
+
+bool json_spirit::read_file( const std::string& path, cValue& value, Error_position& error )
+{
+    return read_mapped_file( path, value, &error );
+}
+
+void json_spirit::read_file_or_throw( const std::string& path, cValue& value )
+{
+    read_mapped_file_or_throw( path, value );
+}
+
+bool json_spirit::read_file( const std::string& path, aValue& value )
+{
+    return read_mapped_file( path, value );
+}
+
+bool json_spirit::read_file( const std::string& path, aValue& value, Error_position& error )
+{
+    return read_mapped_file( path, value, &error );
+}
+
+void json_spirit::read_file_or_throw( const std::string& path, aValue& value )
+{
+    read_mapped_file_or_throw( path, value );
+}
+
+bool json_spirit::read_file( const std::string& path, amValue& value )
+{
+    return read_mapped_file( path, value );
+}
+
+bool json_spirit::read_file( const std::string& path, amValue& value, Error_position& error )
+{
+    return read_mapped_file( path, value, &error );
+}
+
+void json_spirit::read_file_or_throw( const std::string& path, amValue& value )
+{
+    read_mapped_file_or_throw( path, value );
+}
+
+template< class Value_type >
+bool json_spirit::read_lines( const std::string& s, const typename Line_callback< Value_type >::type& callback,
+                              unsigned int nb_threads, Line_order order )
+{
+    Error_position error;
+
+    return read_lines_string< Value_type >( s, callback, error, nb_threads, order );
+}
+
+template< class Value_type >
+bool json_spirit::read_lines( const std::string& s, const typename Line_callback< Value_type >::type& callback, Error_position& error,
+                              unsigned int nb_threads, Line_order order )
+{
+    return read_lines_string< Value_type >( s, callback, error, nb_threads, order );
+}
+
+template< class Value_type >
+void json_spirit::read_lines_or_throw( const std::string& s, const typename Line_callback< Value_type >::type& callback,
+                                       unsigned int nb_threads, Line_order order )
+{
+    Error_position error;
+
+    if( !read_lines_string< Value_type >( s, callback, error, nb_threads, order ) ) throw error;
+}
+
+template bool json_spirit::read_lines< Value >( const std::string&, const Line_callback< Value >::type&, unsigned int, Line_order );
+template bool json_spirit::read_lines< Value >( const std::string&, const Line_callback< Value >::type&, Error_position&, unsigned int, Line_order );
+template void json_spirit::read_lines_or_throw< Value >( const std::string&, const Line_callback< Value >::type&, unsigned int, Line_order );
+
+template bool json_spirit::read_lines< mValue >( const std::string&, const Line_callback< mValue >::type&, unsigned int, Line_order );
+template bool json_spirit::read_lines< mValue >( const std::string&, const Line_callback< mValue >::type&, Error_position&, unsigned int, Line_order );
+template void json_spirit::read_lines_or_throw< mValue >( const std::string&, const Line_callback< mValue >::type&, unsigned int, Line_order );
+
+template< class Value_type >
+bool json_spirit::read_in_parallel( const std::string& s, Value_type& value, unsigned int nb_threads )
+{
+    return read_chars_in_parallel( s.data(), s.data() + s.size(), value, 0, nb_threads );
+}
+
+template< class Value_type >
+bool json_spirit::read_in_parallel( const std::string& s, Value_type& value, Error_position& error, unsigned int nb_threads )
+{
+    return read_chars_in_parallel( s.data(), s.data() + s.size(), value, &error, nb_threads );
+}
+
+template< class Value_type >
+void json_spirit::read_in_parallel_or_throw( const std::string& s, Value_type& value, unsigned int nb_threads )
+{
+    Error_position error;
+
+    if( !read_chars_in_parallel( s.data(), s.data() + s.size(), value, &error, nb_threads ) ) throw error;
+}
+
+template< class Value_type >
+bool json_spirit::read_file_in_parallel( const std::string& path, Value_type& value, unsigned int nb_threads )
+{
+    return read_mapped_file_in_parallel( path, value, 0, nb_threads );
+}
+
+template< class Value_type >
+bool json_spirit::read_file_in_parallel( const std::string& path, Value_type& value, Error_position& error, unsigned int nb_threads )
+{
+    return read_mapped_file_in_parallel( path, value, &error, nb_threads );
+}
+
+template< class Value_type >
+void json_spirit::read_file_in_parallel_or_throw( const std::string& path, Value_type& value, unsigned int nb_threads )
+{
+    Error_position error;
+
+    if( !read_mapped_file_in_parallel( path, value, &error, nb_threads ) ) throw error;
+}
+
+template bool json_spirit::read_in_parallel< Value >( const std::string&, Value&, unsigned int );
+template bool json_spirit::read_in_parallel< Value >( const std::string&, Value&, Error_position&, unsigned int );
+template void json_spirit::read_in_parallel_or_throw< Value >( const std::string&, Value&, unsigned int );
+template bool json_spirit::read_file_in_parallel< Value >( const std::string&, Value&, unsigned int );
+template bool json_spirit::read_file_in_parallel< Value >( const std::string&, Value&, Error_position&, unsigned int );
+template void json_spirit::read_file_in_parallel_or_throw< Value >( const std::string&, Value&, unsigned int );
+
+template bool json_spirit::read_in_parallel< mValue >( const std::string&, mValue&, unsigned int );
+template bool json_spirit::read_in_parallel< mValue >( const std::string&, mValue&, Error_position&, unsigned int );
+template void json_spirit::read_in_parallel_or_throw< mValue >( const std::string&, mValue&, unsigned int );
+template bool json_spirit::read_file_in_parallel< mValue >( const std::string&, mValue&, unsigned int );
+template bool json_spirit::read_file_in_parallel< mValue >( const std::string&, mValue&, Error_position&, unsigned int );
+template void json_spirit::read_file_in_parallel_or_throw< mValue >( const std::string&, mValue&, unsigned int );
+
+bool json_spirit::read( const std::string& s, vValue& value )
+{
+    return read_string( s, value );
+}
+
+bool json_spirit::read( const std::string& s, vValue& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::string& s, vValue& value )
+{
+    read_string_or_throw( s, value );
+}
+
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, vValue& value )
+{
+    return read_range( begin, end, value );
+}
+
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, vValue& value, Error_position& error )
+{
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, vValue& value )
+{
+    read_range_or_throw( begin, end, value );
+}
+
+#ifndef BOOST_NO_STD_WSTRING
+
+bool json_spirit::read( const std::wstring& s, wvValue& value )
+{
+    return read_string( s, value );
+}
+
+bool json_spirit::read( const std::wstring& s, wvValue& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::wstring& s, wvValue& value )
+{
+    read_string_or_throw( s, value );
+}
+
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wvValue& value )
+{
+    return read_range( begin, end, value );
+}
+
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wvValue& value, Error_position& error )
+{
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wvValue& value )
+{
+    read_range_or_throw( begin, end, value );
+}
+
+#endif
+
+bool json_spirit::read( const std::string& s, iValue& value )
+{
+    return read_string( s, value );
+}
+
+bool json_spirit::read( const std::string& s, iValue& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::string& s, iValue& value )
+{
+    read_string_or_throw( s, value );
+}
+
+bool json_spirit::read( std::istream& is, iValue& value )
+{
     return read_stream( is, value );
 }
 
-void json_spirit::read_or_throw( std::wistream& is, wValue& value )
+bool json_spirit::read( std::istream& is, iValue& value, Error_position& error )
+{
+    return read_stream( is, value, &error );
+}
+
+void json_spirit::read_or_throw( std::istream& is, iValue& value )
 {
     read_stream_or_throw( is, value );
 }
 
-bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wValue& value )
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, iValue& value )
 {
     return read_range( begin, end, value );
 }
 
-void json_spirit::read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wValue& value )
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, iValue& value, Error_position& error )
+{
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, iValue& value )
+{
+    read_range_or_throw( begin, end, value );
+}
+
+#ifndef BOOST_NO_STD_WSTRING
+
+bool json_spirit::read( const std::wstring& s, wiValue& value )
+{
+    return read_string( s, value );
+}
+
+bool json_spirit::read( const std::wstring& s, wiValue& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::wstring& s, wiValue& value )
+{
+    read_string_or_throw( s, value );
+}
+
+bool json_spirit::read( std::wistream& is, wiValue& value )
+{
+    return read_stream( is, value );
+}
+
+bool json_spirit::read( std::wistream& is, wiValue& value, Error_position& error )
+{
+    return read_stream( is, value, &error );
+}
+
+void json_spirit::read_or_throw( std::wistream& is, wiValue& value )
+{
+    read_stream_or_throw( is, value );
+}
+
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wiValue& value )
+{
+    return read_range( begin, end, value );
+}
+
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wiValue& value, Error_position& error )
 {
-    begin = read_range_or_throw( begin, end, value );
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wiValue& value )
+{
+    read_range_or_throw( begin, end, value );
 }
 
 #endif
 
-bool json_spirit::read( const std::string& s, mValue& value )
+bool json_spirit::read_file( const std::string& path, iValue& value )
+{
+    return read_mapped_file( path, value );
+}
+
+bool json_spirit::read_file( const std::string& path, iValue& value, Error_position& error )
+{
+    return read_mapped_file( path, value, &error );
+}
+
+void json_spirit::read_file_or_throw( const std::string& path, iValue& value )
+{
+    read_mapped_file_or_throw( path, value );
+}
+
+bool json_spirit::read( const std::string& s, hValue& value )
 {
     return read_string( s, value );
 }
 
-void json_spirit::read_or_throw( const std::string& s, mValue& value )
+bool json_spirit::read( const std::string& s, hValue& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::string& s, hValue& value )
 {
     read_string_or_throw( s, value );
 }
 
-bool json_spirit::read( std::istream& is, mValue& value )
+bool json_spirit::read( std::istream& is, hValue& value )
 {
     return read_stream( is, value );
 }
 
-void json_spirit::read_or_throw( std::istream& is, mValue& value )
+bool json_spirit::read( std::istream& is, hValue& value, Error_position& error )
+{
+    return read_stream( is, value, &error );
+}
+
+void json_spirit::read_or_throw( std::istream& is, hValue& value )
 {
     read_stream_or_throw( is, value );
 }
 
-bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, mValue& value )
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, hValue& value )
 {
     return read_range( begin, end, value );
 }
 
-void json_spirit::read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, mValue& value )
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, hValue& value, Error_position& error )
 {
-    begin = read_range_or_throw( begin, end, value );
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, hValue& value )
+{
+    read_range_or_throw( begin, end, value );
 }
 
 #ifndef BOOST_NO_STD_WSTRING
 
-bool json_spirit::read( const std::wstring& s, wmValue& value )
+bool json_spirit::read( const std::wstring& s, whValue& value )
 {
     return read_string( s, value );
 }
 
-void json_spirit::read_or_throw( const std::wstring& s, wmValue& value )
+bool json_spirit::read( const std::wstring& s, whValue& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::wstring& s, whValue& value )
 {
     read_string_or_throw( s, value );
 }
 
-bool json_spirit::read( std::wistream& is, wmValue& value )
+bool json_spirit::read( std::wistream& is, whValue& value )
 {
     return read_stream( is, value );
 }
 
-void json_spirit::read_or_throw( std::wistream& is, wmValue& value )
+bool json_spirit::read( std::wistream& is, whValue& value, Error_position& error )
+{
+    return read_stream( is, value, &error );
+}
+
+void json_spirit::read_or_throw( std::wistream& is, whValue& value )
 {
     read_stream_or_throw( is, value );
 }
 
-bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wmValue& value )
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, whValue& value )
 {
     return read_range( begin, end, value );
 }
 
-void json_spirit::read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wmValue& value )
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, whValue& value, Error_position& error )
+{
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, whValue& value )
+{
+    read_range_or_throw( begin, end, value );
+}
+
+#endif
+
+bool json_spirit::read_file( const std::string& path, hValue& value )
+{
+    return read_mapped_file( path, value );
+}
+
+bool json_spirit::read_file( const std::string& path, hValue& value, Error_position& error )
+{
+    return read_mapped_file( path, value, &error );
+}
+
+void json_spirit::read_file_or_throw( const std::string& path, hValue& value )
+{
+    read_mapped_file_or_throw( path, value );
+}
+
+bool json_spirit::read( const std::string& s, fValue& value )
+{
+    return read_string( s, value );
+}
+
+bool json_spirit::read( const std::string& s, fValue& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::string& s, fValue& value )
+{
+    read_string_or_throw( s, value );
+}
+
+bool json_spirit::read( std::istream& is, fValue& value )
+{
+    return read_stream( is, value );
+}
+
+bool json_spirit::read( std::istream& is, fValue& value, Error_position& error )
+{
+    return read_stream( is, value, &error );
+}
+
+void json_spirit::read_or_throw( std::istream& is, fValue& value )
+{
+    read_stream_or_throw( is, value );
+}
+
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, fValue& value )
+{
+    return read_range( begin, end, value );
+}
+
+bool json_spirit::read( std::string::const_iterator& begin, std::string::const_iterator end, fValue& value, Error_position& error )
+{
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, fValue& value )
+{
+    read_range_or_throw( begin, end, value );
+}
+
+#ifndef BOOST_NO_STD_WSTRING
+
+bool json_spirit::read( const std::wstring& s, wfValue& value )
+{
+    return read_string( s, value );
+}
+
+bool json_spirit::read( const std::wstring& s, wfValue& value, Error_position& error )
+{
+    return read_string( s, value, &error );
+}
+
+void json_spirit::read_or_throw( const std::wstring& s, wfValue& value )
+{
+    read_string_or_throw( s, value );
+}
+
+bool json_spirit::read( std::wistream& is, wfValue& value )
+{
+    return read_stream( is, value );
+}
+
+bool json_spirit::read( std::wistream& is, wfValue& value, Error_position& error )
+{
+    return read_stream( is, value, &error );
+}
+
+void json_spirit::read_or_throw( std::wistream& is, wfValue& value )
+{
+    read_stream_or_throw( is, value );
+}
+
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wfValue& value )
 {
-    begin = read_range_or_throw( begin, end, value );
+    return read_range( begin, end, value );
+}
+
+bool json_spirit::read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wfValue& value, Error_position& error )
+{
+    return read_range( begin, end, value, &error );
+}
+
+void json_spirit::read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wfValue& value )
+{
+    read_range_or_throw( begin, end, value );
 }
 
 #endif
+
+bool json_spirit::read_file( const std::string& path, fValue& value )
+{
+    return read_mapped_file( path, value );
+}
+
+bool json_spirit::read_file( const std::string& path, fValue& value, Error_position& error )
+{
+    return read_mapped_file( path, value, &error );
+}
+
+void json_spirit::read_file_or_throw( const std::string& path, fValue& value )
+{
+    read_mapped_file_or_throw( path, value );
+}
@@ -11,13 +11,22 @@
 #endif
 
 #include "json_spirit_value.h"
+#include "json_spirit_compact_value.h"
+#include "json_spirit_hash_object.h"
+#include "json_spirit_flat_object.h"
 #include <iostream>
+#include <cstddef>
+#include <boost/function.hpp>
 
 namespace json_spirit
 {
     // An Error_position exception is thrown by the "read_or_throw" functions below on finding an error.
-    // Note the "read_or_throw" functions are around 3 times slower than the standard functions "read" 
-    // functions that return a bool.
+    // The "read" functions that take an Error_position argument fill it in instead, they never throw 
+    // and so are the cheaper choice when malformed input is common.
+    //
+    // Any number of threads may read at the same time, without locking, provided that each reads 
+    // into its own value. Nothing is shared between reads, unless json_spirit_reader.cpp is built 
+    // with JSON_SPIRIT_USE_SPIRIT_GRAMMER, which also needs BOOST_SPIRIT_THREADSAFE.
     //
     struct Error_position
     {
@@ -35,6 +44,10 @@ namespace json_spirit
     bool read( std::istream&  is,    Value& value );
     bool read( std::string::const_iterator& begin, std::string::const_iterator end, Value& value );
 
+    bool read( const std::string& s, Value& value, Error_position& error );
+    bool read( std::istream&  is,    Value& value, Error_position& error );
+    bool read( std::string::const_iterator& begin, std::string::const_iterator end, Value& value, Error_position& error );
+
     void read_or_throw( const std::string& s, Value& value );  
     void read_or_throw( std::istream&  is,    Value& value );
     void read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, Value& value );
@@ -45,6 +58,10 @@ namespace json_spirit
     bool read( std::wistream&  is,    wValue& value );
     bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wValue& value );    
 
+    bool read( const std::wstring& s, wValue& value, Error_position& error );
+    bool read( std::wistream&  is,    wValue& value, Error_position& error );
+    bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wValue& value, Error_position& error );
+
     void read_or_throw( const std::wstring& s, wValue& value );
     void read_or_throw( std::wistream&  is,    wValue& value );
     void read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wValue& value );
@@ -55,6 +72,10 @@ namespace json_spirit
     bool read( std::istream&  is,    mValue& value );
     bool read( std::string::const_iterator& begin, std::string::const_iterator end, mValue& value );
 
+    bool read( const std::string& s, mValue& value, Error_position& error );
+    bool read( std::istream&  is,    mValue& value, Error_position& error );
+    bool read( std::string::const_iterator& begin, std::string::const_iterator end, mValue& value, Error_position& error );
+
     void read_or_throw( const std::string& s, mValue& value );  
     void read_or_throw( std::istream&  is,    mValue& value );
     void read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, mValue& value );
@@ -65,11 +86,333 @@ namespace json_spirit
     bool read( std::wistream&  is,    wmValue& value );
     bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wmValue& value );    
 
+    bool read( const std::wstring& s, wmValue& value, Error_position& error );
+    bool read( std::wistream&  is,    wmValue& value, Error_position& error );
+    bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wmValue& value, Error_position& error );
+
     void read_or_throw( const std::wstring& s, wmValue& value );
     void read_or_throw( std::wistream&  is,    wmValue& value );
     void read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wmValue& value );
 
 #endif
+
+    bool read( const std::string& s, cValue& value );
+    bool read( std::istream&  is,    cValue& value );
+    bool read( std::string::const_iterator& begin, std::string::const_iterator end, cValue& value );
+
+    bool read( const std::string& s, cValue& value, Error_position& error );
+    bool read( std::istream&  is,    cValue& value, Error_position& error );
+    bool read( std::string::const_iterator& begin, std::string::const_iterator end, cValue& value, Error_position& error );
+
+    void read_or_throw( const std::string& s, cValue& value );  
+    void read_or_throw( std::istream&  is,    cValue& value );
+    void read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, cValue& value );
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    bool read( const std::wstring& s, wcValue& value );
+    bool read( std::wistream&  is,    wcValue& value );
+    bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wcValue& value );    
+
+    bool read( const std::wstring& s, wcValue& value, Error_position& error );
+    bool read( std::wistream&  is,    wcValue& value, Error_position& error );
+    bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wcValue& value, Error_position& error );
+
+    void read_or_throw( const std::wstring& s, wcValue& value );
+    void read_or_throw( std::wistream&  is,    wcValue& value );
+    void read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wcValue& value );
+
+#endif
+
+    bool read( const std::string& s, aValue& value );
+    bool read( std::istream&  is,    aValue& value );
+    bool read( std::string::const_iterator& begin, std::string::const_iterator end, aValue& value );
+
+    bool read( const std::string& s, aValue& value, Error_position& error );
+    bool read( std::istream&  is,    aValue& value, Error_position& error );
+    bool read( std::string::const_iterator& begin, std::string::const_iterator end, aValue& value, Error_position& error );
+
+    void read_or_throw( const std::string& s, aValue& value );  
+    void read_or_throw( std::istream&  is,    aValue& value );
+    void read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, aValue& value );
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    bool read( const std::wstring& s, waValue& value );
+    bool read( std::wistream&  is,    waValue& value );
+    bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, waValue& value );    
+
+    bool read( const std::wstring& s, waValue& value, Error_position& error );
+    bool read( std::wistream&  is,    waValue& value, Error_position& error );
+    bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, waValue& value, Error_position& error );
+
+    void read_or_throw( const std::wstring& s, waValue& value );
+    void read_or_throw( std::wistream&  is,    waValue& value );
+    void read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, waValue& value );
+
+#endif
+
+    bool read( const std::string& s, amValue& value );
+    bool read( std::istream&  is,    amValue& value );
+    bool read( std::string::const_iterator& begin, std::string::const_iterator end, amValue& value );
+
+    bool read( const std::string& s, amValue& value, Error_position& error );
+    bool read( std::istream&  is,    amValue& value, Error_position& error );
+    bool read( std::string::const_iterator& begin, std::string::const_iterator end, amValue& value, Error_position& error );
+
+    void read_or_throw( const std::string& s, amValue& value );  
+    void read_or_throw( std::istream&  is,    amValue& value );
+    void read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, amValue& value );
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    bool read( const std::wstring& s, wamValue& value );
+    bool read( std::wistream&  is,    wamValue& value );
+    bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wamValue& value );    
+
+    bool read( const std::wstring& s, wamValue& value, Error_position& error );
+    bool read( std::wistream&  is,    wamValue& value, Error_position& error );
+    bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wamValue& value, Error_position& error );
+
+    void read_or_throw( const std::wstring& s, wamValue& value );
+    void read_or_throw( std::wistream&  is,    wamValue& value );
+    void read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wamValue& value );
+
+#endif
+
+    // Functions to read a JSON value from the file at path. Large files are mapped into memory and
+    // parsed where they are, without being copied into a string or going through a stream. If the 
+    // file cannot be read the error has line and column 0. There are no wide versions as a file
+    // holds bytes, convert the text and use the wide read() functions instead.
+
+    bool read_file( const std::string& path, Value& value );
+    bool read_file( const std::string& path, Value& value, Error_position& error );
+    void read_file_or_throw( const std::string& path, Value& value );
+
+    bool read_file( const std::string& path, mValue& value );
+    bool read_file( const std::string& path, mValue& value, Error_position& error );
+    void read_file_or_throw( const std::string& path, mValue& value );
+
+    bool read_file( const std::string& path, cValue& value );
+    bool read_file( const std::string& path, cValue& value, Error_position& error );
+    void read_file_or_throw( const std::string& path, cValue& value );
+
+    bool read_file( const std::string& path, aValue& value );
+    bool read_file( const std::string& path, aValue& value, Error_position& error );
+    void read_file_or_throw( const std::string& path, aValue& value );
+
+    bool read_file( const std::string& path, amValue& value );
+    bool read_file( const std::string& path, amValue& value, Error_position& error );
+    void read_file_or_throw( const std::string& path, amValue& value );
+
+    // Functions to read newline delimited JSON, also known as JSON Lines, eg. a log file with a 
+    // value on each line. The lines are parsed in parallel, by nb_threads threads or one per core
+    // if nb_threads is 0, and each value is passed to the callback with its line number, counted 
+    // from 1, eg.
+    //
+    //    read_lines< mValue >( text, handle_line );
+    //
+    // Lines holding only white space are skipped. A malformed line does not stop the others from
+    // being read, the error reported, or thrown by read_lines_or_throw() once the other lines
+    // have been read, is that of the first malformed line. With lines_in_order the callback is
+    // called on the calling thread, a line at a time in line order. With lines_in_any_order it is
+    // called as each line is parsed, on any of the threads, and must be safe to call concurrently.
+    // An exception thrown by the callback stops the read and is rethrown. Only Value and mValue 
+    // can be read.
+
+    enum Line_order{ lines_in_order, lines_in_any_order };
+
+    template< class Value_type >
+    struct Line_callback
+    {
+        typedef boost::function< void ( std::size_t line, Value_type& value ) > type;
+    };
+
+    template< class Value_type >
+    bool read_lines( const std::string& s, const typename Line_callback< Value_type >::type& callback,
+                     unsigned int nb_threads = 0, Line_order order = lines_in_order );
+
+    template< class Value_type >
+    bool read_lines( const std::string& s, const typename Line_callback< Value_type >::type& callback, Error_position& error,
+                     unsigned int nb_threads = 0, Line_order order = lines_in_order );
+
+    template< class Value_type >
+    void read_lines_or_throw( const std::string& s, const typename Line_callback< Value_type >::type& callback,
+                              unsigned int nb_threads = 0, Line_order order = lines_in_order );
+
+    // Functions to read a large document that is a single array, eg. a bulk export of records, on 
+    // several threads, nb_threads or one per core if nb_threads is 0. The top level array is split
+    // between its elements, the parts are parsed in parallel and their elements are moved into the
+    // final array. The value and any error are the same as read() gives. A malformed document is 
+    // read again on one thread to find its error. Documents that are not arrays, or are too small 
+    // to be worth splitting, are read on the calling thread. Only Value and mValue can be read.
+
+    template< class Value_type >
+    bool read_in_parallel( const std::string& s, Value_type& value, unsigned int nb_threads = 0 );
+
+    template< class Value_type >
+    bool read_in_parallel( const std::string& s, Value_type& value, Error_position& error, unsigned int nb_threads = 0 );
+
+    template< class Value_type >
+    void read_in_parallel_or_throw( const std::string& s, Value_type& value, unsigned int nb_threads = 0 );
+
+    template< class Value_type >
+    bool read_file_in_parallel( const std::string& path, Value_type& value, unsigned int nb_threads = 0 );
+
+    template< class Value_type >
+    bool read_file_in_parallel( const std::string& path, Value_type& value, Error_position& error, unsigned int nb_threads = 0 );
+
+    template< class Value_type >
+    void read_file_in_parallel_or_throw( const std::string& path, Value_type& value, unsigned int nb_threads = 0 );
+
+    // The strings of a vValue refer to the text that was read, which must not be changed or destroyed 
+    // while the value is in use. Only strings containing escape sequences are copied. There are no
+    // stream versions as a stream's text does not outlive the read.
+
+    bool read( const std::string& s, vValue& value );
+    bool read( std::string::const_iterator& begin, std::string::const_iterator end, vValue& value );
+
+    bool read( const std::string& s, vValue& value, Error_position& error );
+    bool read( std::string::const_iterator& begin, std::string::const_iterator end, vValue& value, Error_position& error );
+
+    void read_or_throw( const std::string& s, vValue& value );  
+    void read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, vValue& value );
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    bool read( const std::wstring& s, wvValue& value );
+    bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wvValue& value );
+
+    bool read( const std::wstring& s, wvValue& value, Error_position& error );
+    bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wvValue& value, Error_position& error );
+
+    void read_or_throw( const std::wstring& s, wvValue& value );  
+    void read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wvValue& value );
+
+#endif
+
+#if !defined( BOOST_NO_CXX11_RVALUE_REFERENCES ) && !defined( BOOST_NO_CXX11_DELETED_FUNCTIONS )
+
+    // a vValue read from a temporary would refer to text that has been destroyed
+
+    bool read( std::string&& s, vValue& value ) = delete;
+    bool read( std::string&& s, vValue& value, Error_position& error ) = delete;
+    void read_or_throw( std::string&& s, vValue& value ) = delete;
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    bool read( std::wstring&& s, wvValue& value ) = delete;
+    bool read( std::wstring&& s, wvValue& value, Error_position& error ) = delete;
+    void read_or_throw( std::wstring&& s, wvValue& value ) = delete;
+
+#endif
+#endif
+
+    // The member names of an iValue are interned, each distinct name is stored once and shared by
+    // every member with that name, see json_spirit_interned_string.h.
+
+    bool read( const std::string& s, iValue& value );
+    bool read( std::istream&  is,    iValue& value );
+    bool read( std::string::const_iterator& begin, std::string::const_iterator end, iValue& value );
+
+    bool read( const std::string& s, iValue& value, Error_position& error );
+    bool read( std::istream&  is,    iValue& value, Error_position& error );
+    bool read( std::string::const_iterator& begin, std::string::const_iterator end, iValue& value, Error_position& error );
+
+    void read_or_throw( const std::string& s, iValue& value );  
+    void read_or_throw( std::istream&  is,    iValue& value );
+    void read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, iValue& value );
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    bool read( const std::wstring& s, wiValue& value );
+    bool read( std::wistream&  is,    wiValue& value );
+    bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wiValue& value );    
+
+    bool read( const std::wstring& s, wiValue& value, Error_position& error );
+    bool read( std::wistream&  is,    wiValue& value, Error_position& error );
+    bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wiValue& value, Error_position& error );
+
+    void read_or_throw( const std::wstring& s, wiValue& value );
+    void read_or_throw( std::wistream&  is,    wiValue& value );
+    void read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wiValue& value );
+
+#endif
+
+    bool read_file( const std::string& path, iValue& value );
+    bool read_file( const std::string& path, iValue& value, Error_position& error );
+    void read_file_or_throw( const std::string& path, iValue& value );
+
+    // The objects of an hValue keep their members in order and find them through a hash table,
+    // see json_spirit_hash_object.h. As for an mValue, the last of several members with the same
+    // name is kept.
+
+    bool read( const std::string& s, hValue& value );
+    bool read( std::istream&  is,    hValue& value );
+    bool read( std::string::const_iterator& begin, std::string::const_iterator end, hValue& value );
+
+    bool read( const std::string& s, hValue& value, Error_position& error );
+    bool read( std::istream&  is,    hValue& value, Error_position& error );
+    bool read( std::string::const_iterator& begin, std::string::const_iterator end, hValue& value, Error_position& error );
+
+    void read_or_throw( const std::string& s, hValue& value );  
+    void read_or_throw( std::istream&  is,    hValue& value );
+    void read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, hValue& value );
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    bool read( const std::wstring& s, whValue& value );
+    bool read( std::wistream&  is,    whValue& value );
+    bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, whValue& value );    
+
+    bool read( const std::wstring& s, whValue& value, Error_position& error );
+    bool read( std::wistream&  is,    whValue& value, Error_position& error );
+    bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, whValue& value, Error_position& error );
+
+    void read_or_throw( const std::wstring& s, whValue& value );
+    void read_or_throw( std::wistream&  is,    whValue& value );
+    void read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, whValue& value );
+
+#endif
+
+    bool read_file( const std::string& path, hValue& value );
+    bool read_file( const std::string& path, hValue& value, Error_position& error );
+    void read_file_or_throw( const std::string& path, hValue& value );
+
+    // The objects of an fValue are vectors sorted by name, see json_spirit_flat_object.h. As for an
+    // mValue, the last of several members with the same name is kept.
+
+    bool read( const std::string& s, fValue& value );
+    bool read( std::istream&  is,    fValue& value );
+    bool read( std::string::const_iterator& begin, std::string::const_iterator end, fValue& value );
+
+    bool read( const std::string& s, fValue& value, Error_position& error );
+    bool read( std::istream&  is,    fValue& value, Error_position& error );
+    bool read( std::string::const_iterator& begin, std::string::const_iterator end, fValue& value, Error_position& error );
+
+    void read_or_throw( const std::string& s, fValue& value );  
+    void read_or_throw( std::istream&  is,    fValue& value );
+    void read_or_throw( std::string::const_iterator& begin, std::string::const_iterator end, fValue& value );
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    bool read( const std::wstring& s, wfValue& value );
+    bool read( std::wistream&  is,    wfValue& value );
+    bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wfValue& value );    
+
+    bool read( const std::wstring& s, wfValue& value, Error_position& error );
+    bool read( std::wistream&  is,    wfValue& value, Error_position& error );
+    bool read( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wfValue& value, Error_position& error );
+
+    void read_or_throw( const std::wstring& s, wfValue& value );
+    void read_or_throw( std::wistream&  is,    wfValue& value );
+    void read_or_throw( std::wstring::const_iterator& begin, std::wstring::const_iterator end, wfValue& value );
+
+#endif
+
+    bool read_file( const std::string& path, fValue& value );
+    bool read_file( const std::string& path, fValue& value, Error_position& error );
+    void read_file_or_throw( const std::string& path, fValue& value );
 }
 
 #endif
@@ -0,0 +1,1284 @@
+#ifndef JASON_SPIRIT_READER_TEMPLATE
+#define JASON_SPIRIT_READER_TEMPLATE
+
+//          Copyright John W. Wilkinson 2007 - 2009.
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+// json spirit version 4.02
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include "json_spirit_reader.h"
+#include "json_spirit_number.h"
+#include "json_spirit_simd.h"
+#include "json_spirit_string_view.h"
+#include "json_spirit_interned_string.h"
+#include "json_spirit_flat_object.h"
+
+#include <cassert>
+#include <cctype>
+#include <cstddef>
+#include <cwctype>
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/static_assert.hpp>
+
+namespace json_spirit
+{
+    // Functions to read a JSON value as a sequence of events rather than as a Value. The handler's
+    // member functions are called as each part of the value is parsed:
+    //
+    //    struct Handler
+    //    {
+    //        void begin_obj();
+    //        void end_obj();
+    //        void begin_array();
+    //        void end_array();
+    //        void new_name( const std::string& name );
+    //        void new_str( const std::string& s );
+    //        void new_bool( bool b );
+    //        void new_null();
+    //        void new_int( boost::int64_t i );
+    //        void new_uint64( boost::uint64_t i );  // only for integers too large for an int64_t
+    //        void new_real( double d );
+    //    };
+    //
+    // Nothing is kept once it has been passed to the handler, so a document of any size is read
+    // in memory proportional to its depth. The strings are std::wstrings when reading wide text.
+    // On a syntax error the handler has seen the events for the text before the error.
+    //
+    template< class Handler >
+    bool read_events( const std::string& s, Handler& handler );
+    template< class Handler >
+    bool read_events( const std::string& s, Handler& handler, Error_position& error );
+    template< class Handler >
+    void read_events_or_throw( const std::string& s, Handler& handler );
+
+    // on success begin is advanced to the first character after the value,
+    // Iter_type can be any forward iterator over chars or wchar_ts
+
+    template< class Iter_type, class Handler >
+    bool read_events( Iter_type& begin, Iter_type end, Handler& handler );
+    template< class Iter_type, class Handler >
+    bool read_events( Iter_type& begin, Iter_type end, Handler& handler, Error_position& error );
+    template< class Iter_type, class Handler >
+    void read_events_or_throw( Iter_type& begin, Iter_type end, Handler& handler );
+
+#ifndef BOOST_NO_STD_WSTRING
+    template< class Handler >
+    bool read_events( const std::wstring& s, Handler& handler );
+    template< class Handler >
+    bool read_events( const std::wstring& s, Handler& handler, Error_position& error );
+    template< class Handler >
+    void read_events_or_throw( const std::wstring& s, Handler& handler );
+#endif
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // implementation, also used by json_spirit_reader.cpp
+
+    namespace internal_
+    {
+        template< class Iter_type >
+        bool is_eq( Iter_type first, Iter_type last, const char* c_str )
+        {
+            for( Iter_type i = first; i != last; ++i, ++c_str )
+            {
+                if( *c_str == 0 ) return false;
+
+                if( *i != *c_str ) return false;
+            }
+
+            return true;
+        }
+
+        template< class Char_type >
+        bool is_hex_digit( Char_type c )
+        {
+            return ( ( c >= '0' ) && ( c <= '9' ) ) ||
+                   ( ( c >= 'a' ) && ( c <= 'f' ) ) ||
+                   ( ( c >= 'A' ) && ( c <= 'F' ) );
+        }
+
+        template< class Char_type >
+        Char_type hex_to_num( const Char_type c )
+        {
+            if( ( c >= '0' ) && ( c <= '9' ) ) return c - '0';
+            if( ( c >= 'a' ) && ( c <= 'f' ) ) return c - 'a' + 10;
+            if( ( c >= 'A' ) && ( c <= 'F' ) ) return c - 'A' + 10;
+            return 0;
+        }
+
+        template< class Char_type, class Iter_type >
+        Char_type hex_str_to_char( Iter_type& begin )
+        {
+            const Char_type c1( *( ++begin ) );
+            const Char_type c2( *( ++begin ) );
+
+            return ( hex_to_num( c1 ) << 4 ) + hex_to_num( c2 );
+        }       
+
+        template< class Char_type, class Iter_type >
+        Char_type unicode_str_to_char( Iter_type& begin )
+        {
+            const Char_type c1( *( ++begin ) );
+            const Char_type c2( *( ++begin ) );
+            const Char_type c3( *( ++begin ) );
+            const Char_type c4( *( ++begin ) );
+
+            return ( hex_to_num( c1 ) << 12 ) + 
+                   ( hex_to_num( c2 ) <<  8 ) + 
+                   ( hex_to_num( c3 ) <<  4 ) + 
+                   hex_to_num( c4 );
+        }
+
+        template< class String_type, class Iter_type >
+        void append_esc_char_and_incr_iter( String_type& s, Iter_type& begin, Iter_type end )
+        {
+            typedef typename String_type::value_type Char_type;
+
+            const Char_type c2( *begin );
+
+            switch( c2 )
+            {
+                case 't':  s += '\t'; break;
+                case 'b':  s += '\b'; break;
+                case 'f':  s += '\f'; break;
+                case 'n':  s += '\n'; break;
+                case 'r':  s += '\r'; break;
+                case '\\': s += '\\'; break;
+                case '/':  s += '/';  break;
+                case '"':  s += '"';  break;
+                case 'x':  
+                {
+                    if( end - begin >= 3 )  //  expecting "xHH..."
+                    {
+                        s += hex_str_to_char< Char_type >( begin );  
+                    }
+                    break;
+                }
+                case 'u':  
+                {
+                    if( end - begin >= 5 )  //  expecting "uHHHH..."
+                    {
+                        s += unicode_str_to_char< Char_type >( begin );  
+                    }
+                    break;
+                }
+            }
+        }
+
+        // finds the first character in [begin, end) that is c1 or c2, narrow text is compared 
+        // 32 or 16 characters at a time using AVX2 or SSE2 where available
+        //
+        inline const char* find_either( const char* begin, const char* end, char c1, char c2 )
+        {
+#ifdef JSON_SPIRIT_AVX2
+            const __m256i c1s = _mm256_set1_epi8( c1 );
+            const __m256i c2s = _mm256_set1_epi8( c2 );
+
+            for( ; end - begin >= 32; begin += 32 )
+            {
+                const __m256i chars = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( begin ) );
+
+                const unsigned int mask = static_cast< unsigned int >( _mm256_movemask_epi8( 
+                    _mm256_or_si256( _mm256_cmpeq_epi8( chars, c1s ), _mm256_cmpeq_epi8( chars, c2s ) ) ) );
+
+                if( mask != 0 ) return begin + trailing_zeros( mask );
+            }
+#endif
+#ifdef JSON_SPIRIT_SSE2
+            const __m128i c1s_16 = _mm_set1_epi8( c1 );
+            const __m128i c2s_16 = _mm_set1_epi8( c2 );
+
+            for( ; end - begin >= 16; begin += 16 )
+            {
+                const __m128i chars = _mm_loadu_si128( reinterpret_cast< const __m128i* >( begin ) );
+
+                const unsigned int mask = static_cast< unsigned int >( _mm_movemask_epi8( 
+                    _mm_or_si128( _mm_cmpeq_epi8( chars, c1s_16 ), _mm_cmpeq_epi8( chars, c2s_16 ) ) ) );
+
+                if( mask != 0 ) return begin + trailing_zeros( mask );
+            }
+#endif
+            for( ; begin != end; ++begin )
+            {
+                if( *begin == c1 || *begin == c2 ) return begin;
+            }
+
+            return end;
+        }
+
+        template< class Iter_type >
+        Iter_type find_either( Iter_type begin, Iter_type end, char c1, char c2 )
+        {
+            for( ; begin != end; ++begin )
+            {
+                if( *begin == c1 || *begin == c2 ) return begin;
+            }
+
+            return end;
+        }
+
+        inline std::string::const_iterator find_either( std::string::const_iterator begin, std::string::const_iterator end, char c1, char c2 )
+        {
+            if( begin == end ) return end;
+
+            const char* const p = &*begin;
+
+            return begin + ( find_either( p, p + ( end - begin ), c1, c2 ) - p );
+        }
+
+        // the characters between escape sequences are found with find_either() and appended a run at a time
+        //
+        template< class String_type, class Iter_type >
+        String_type substitute_esc_chars( Iter_type begin, Iter_type end )
+        {
+            if( end - begin < 2 ) return String_type( begin, end );
+
+            const Iter_type end_minus_1( end - 1 );
+
+            Iter_type i = find_either( begin, end_minus_1, '\\', '\\' );
+
+            if( i == end_minus_1 ) return String_type( begin, end );
+
+            String_type result;
+
+            result.reserve( end - begin );
+
+            Iter_type substr_start = begin;
+
+            while( i != end_minus_1 )
+            {
+                result.append( substr_start, i );
+
+                ++i;  // skip the '\'
+
+                append_esc_char_and_incr_iter( result, i, end );
+
+                substr_start = ++i;
+
+                if( i >= end_minus_1 ) break;
+
+                i = find_either( i, end_minus_1, '\\', '\\' );
+            }
+
+            result.append( substr_start, end );
+
+            return result;
+        }
+
+        template< class String_type, class Iter_type >
+        String_type get_str_( Iter_type begin, Iter_type end )
+        {
+            assert( end - begin >= 2 );
+
+            Iter_type str_without_quotes( ++begin );
+            Iter_type end_without_quotes( --end );
+
+            return substitute_esc_chars< String_type >( str_without_quotes, end_without_quotes );
+        }
+
+        template< class String_type, class Iter_type >
+        String_type decode_str( Iter_type begin, Iter_type end, boost::false_type )
+        {
+            typedef std::basic_string< typename String_type::value_type > Tmp_string_type;
+
+            const Tmp_string_type tmp( begin, end );  // convert forward iterators to string iterators
+
+            return get_str_< String_type >( tmp.begin(), tmp.end() );
+        }
+
+        template< class String_type, class Iter_type >
+        String_type decode_str( Iter_type begin, Iter_type end, boost::true_type )
+        {
+            return get_str_< String_type >( begin, end );  // already random access, so decode without a copy
+        }
+
+        template< class String_type, class Iter_type >
+        String_type get_str( Iter_type begin, Iter_type end, String_type* )
+        {
+            typedef typename std::iterator_traits< Iter_type >::iterator_category Category;
+
+            return decode_str< String_type >( begin, end, boost::is_convertible< Category, std::random_access_iterator_tag >() );
+        }
+
+        // a string without escapes is referred to where it is in the document, the rest are 
+        // decoded into a string owned by the view, as are all strings read from a stream
+        //
+        template< class Char_type, class Iter_type >
+        String_view< Char_type > get_str_view( Iter_type begin, Iter_type end, boost::false_type )
+        {
+            typedef std::basic_string< Char_type > Decoded_type;
+
+            return String_view< Char_type >::copy_of( get_str( begin, end, static_cast< Decoded_type* >( 0 ) ) );
+        }
+
+        template< class Char_type, class Iter_type >
+        String_view< Char_type > get_str_view( Iter_type begin, Iter_type end, boost::true_type )
+        {
+            const Char_type* const str_begin = &*begin + 1;
+            const Char_type* const str_end   = &*( end - 1 );  // the closing quote
+
+            if( find_either( str_begin, str_end, '\\', '\\' ) == str_end ) return String_view< Char_type >( str_begin, str_end );
+
+            return get_str_view< Char_type >( begin, end, boost::false_type() );
+        }
+
+        template< class Char_type, class Iter_type >
+        String_view< Char_type > get_str( Iter_type begin, Iter_type end, String_view< Char_type >* )
+        {
+            typedef boost::integral_constant< bool, boost::is_same< Iter_type, typename std::basic_string< Char_type >::const_iterator >::value ||
+                                                    boost::is_same< Iter_type, const Char_type* >::value > Is_contiguous;
+
+            return get_str_view< Char_type >( begin, end, Is_contiguous() );
+        }
+
+        // the strings of values are not interned, see Name_table for names
+        //
+        template< class Char_type, class Iter_type >
+        Interned_string< Char_type > get_str( Iter_type begin, Iter_type end, Interned_string< Char_type >* )
+        {
+            typedef std::basic_string< Char_type > Decoded_type;
+
+            return Interned_string< Char_type >( get_str( begin, end, static_cast< Decoded_type* >( 0 ) ) );
+        }
+
+        template< class String_type, class Iter_type >
+        String_type get_str( Iter_type begin, Iter_type end )
+        {
+            return get_str( begin, end, static_cast< String_type* >( 0 ) );
+        }
+
+        // true if the strings read refer to the text they were read from
+
+        template< class String_type >
+        struct Refers_to_text : boost::false_type
+        {
+        };
+
+        template< class Char_type >
+        struct Refers_to_text< String_view< Char_type > > : boost::true_type
+        {
+        };
+
+        // used by Semantic_actions to make the names of object members, only Interned_string 
+        // names are looked up in a table, so that every member with the same name shares its text
+        //
+        template< class String_type >
+        class Name_table
+        {
+        public:
+
+            template< class Iter_type >
+            String_type get_name( Iter_type begin, Iter_type end )
+            {
+                return get_str< String_type >( begin, end );
+            }
+        };
+
+        template< class Char_type >
+        class Name_table< Interned_string< Char_type > >
+        {
+        public:
+
+            typedef Interned_string< Char_type > String_type;
+            typedef std::basic_string< Char_type > Decoded_type;
+
+            template< class Iter_type >
+            String_type get_name( Iter_type begin, Iter_type end )
+            {
+                buffer_ = get_str< Decoded_type >( begin, end );
+
+                const typename Names::const_iterator i = names_.find( buffer_ );
+
+                if( i != names_.end() ) return i->second;
+
+                if( names_.size() >= max_names ) names_.clear();  // objects used as maps would otherwise grow the table without limit
+
+                const String_type name( buffer_ );
+
+                names_.insert( typename Names::value_type( buffer_, name ) );
+
+                return name;
+            }
+
+        private:
+
+            typedef boost::unordered_map< Decoded_type, String_type > Names;
+
+            static const std::size_t max_names = 4096;
+
+            Names names_;
+            Decoded_type buffer_;   // reused, so that names already in the table are decoded without an allocation
+        };
+
+        // finds the line and column of posn, counting them in the same way as Spirit's position_iterator
+        //
+        template< typename Iter_type >
+        Error_position get_error_position( Iter_type begin, Iter_type end, Iter_type posn, const char* reason )
+        {
+            const unsigned int tab_chars = 4;
+
+            unsigned int line   = 1;
+            unsigned int column = 1;
+
+            for( Iter_type i = begin; i != posn; )
+            {
+                const typename std::iterator_traits< Iter_type >::value_type c( *i );
+
+                ++i;
+
+                if( c == '\n' || ( c == '\r' && ( i == end || *i != '\n' ) ) )
+                {
+                    ++line;
+                    column = 1;
+                }
+                else if( c == '\t' )
+                {
+                    column += tab_chars - ( column - 1 ) % tab_chars;
+                }
+                else if( c != '\r' )
+                {
+                    ++column;
+                }
+            }
+
+            return Error_position( line, column, reason );
+        }
+
+        // this class's methods get called by the parser, or the Spirit grammer in 
+        // json_spirit_reader.cpp, resulting in the creation of a JSON object or array
+        //
+        // NB Iter_type could be a std::string iterator, wstring iterator, a user supplied iterator or a Stream_chunk_iter
+        //
+        template< class Value_type, class Iter_type >
+        class Semantic_actions 
+        {
+        public:
+
+            typedef typename Value_type::Config_type Config_type;
+            typedef typename Config_type::String_type String_type;
+            typedef typename Config_type::Object_type Object_type;
+            typedef typename Config_type::Array_type Array_type;
+            typedef typename String_type::value_type Char_type;
+
+            Semantic_actions( Value_type& value )
+            :   value_p_( &value )
+            ,   current_p_( 0 )
+            {
+            }
+
+            Semantic_actions()
+            :   value_p_( 0 )
+            ,   current_p_( 0 )
+            {
+            }
+
+            // starts creating another value, keeping the memory of the stack and name
+
+            void reset( Value_type& value )
+            {
+                value_p_   = &value;
+                current_p_ = 0;
+
+                stack_.clear();
+            }
+
+            void begin_obj( Char_type c )
+            {
+                assert( c == '{' );
+
+                begin_compound< Object_type >();
+            }
+
+            void end_obj( Char_type c )
+            {
+                assert( c == '}' );
+
+                finish_obj( current_p_->get_obj() );
+
+                end_compound();
+            }
+
+            void begin_array( Char_type c )
+            {
+                assert( c == '[' );
+
+                begin_compound< Array_type >();
+            }
+
+            void end_array( Char_type c )
+            {
+                assert( c == ']' );
+
+                end_compound();
+            }
+
+            void new_name( Iter_type begin, Iter_type end )
+            {
+                assert( current_p_->type() == obj_type );
+
+                name_ = names_.get_name( begin, end );
+            }
+
+            void new_str( Iter_type begin, Iter_type end )
+            {
+                add_to_current( get_str< String_type >( begin, end ) );
+            }
+
+            void new_true( Iter_type begin, Iter_type end )
+            {
+                assert( is_eq( begin, end, "true" ) );
+
+                add_to_current( true );
+            }
+
+            void new_false( Iter_type begin, Iter_type end )
+            {
+                assert( is_eq( begin, end, "false" ) );
+
+                add_to_current( false );
+            }
+
+            void new_null( Iter_type begin, Iter_type end )
+            {
+                assert( is_eq( begin, end, "null" ) );
+
+                add_to_current( Value_type() );
+            }
+
+            void new_int( int64_t i )
+            {
+                add_to_current( i );
+            }
+
+            void new_uint64( uint64_t ui )
+            {
+                add_to_current( ui );
+            }
+
+            void new_real( double d )
+            {
+                add_to_current( d );
+            }
+
+            void new_number( const Number& number )
+            {
+                switch( number.type_ )
+                {
+                    case Number::int64:  new_int   ( number.int64_  ); break;
+                    case Number::uint64: new_uint64( number.uint64_ ); break;
+                    case Number::real:   new_real  ( number.real_   ); break;
+                    default: assert( false );
+                }
+            }
+
+        private:
+
+    #ifdef BOOST_NO_CXX11_RVALUE_REFERENCES
+            Value_type* add_first( const Value_type& value )
+            {
+                assert( current_p_ == 0 );
+
+                *value_p_ = value;
+                current_p_ = value_p_;
+                return current_p_;
+            }
+    #else
+            template< class T >
+            Value_type* add_first( T&& value )
+            {
+                assert( current_p_ == 0 );
+
+                *value_p_ = Value_type( std::forward< T >( value ) );
+                current_p_ = value_p_;
+                return current_p_;
+            }
+    #endif
+
+            template< class Array_or_obj >
+            void begin_compound()
+            {
+                if( current_p_ == 0 )
+                {
+                    add_first( Array_or_obj() );
+                }
+                else
+                {
+                    stack_.push_back( current_p_ );
+
+    #ifdef BOOST_NO_CXX11_RVALUE_REFERENCES
+                    Array_or_obj new_array_or_obj;   // avoid copy by building new array or object in place
+
+                    current_p_ = add_to_current( new_array_or_obj );
+    #else
+                    current_p_ = add_to_current( Array_or_obj() );
+    #endif
+                }
+            }
+
+            void end_compound()
+            {
+                if( current_p_ != value_p_ )
+                {
+                    current_p_ = stack_.back();
+
+                    stack_.pop_back();
+                }    
+            }
+
+    #ifdef BOOST_NO_CXX11_RVALUE_REFERENCES
+            Value_type* add_to_current( const Value_type& value )
+            {
+                if( current_p_ == 0 )
+                {
+                    return add_first( value );
+                }
+                else if( current_p_->type() == array_type )
+                {
+                    current_p_->get_array().push_back( value );
+
+                    return &current_p_->get_array().back(); 
+                }
+
+                assert( current_p_->type() == obj_type );
+
+                return &Config_type::add( current_p_->get_obj(), name_, value );
+            }
+    #else
+            // array elements are constructed in place and strings, names and compound values 
+            // are moved into the tree, so nothing is copied once it has been decoded
+            //
+            template< class T >
+            Value_type* add_to_current( T&& value )
+            {
+                if( current_p_ == 0 )
+                {
+                    return add_first( std::forward< T >( value ) );
+                }
+                else if( current_p_->type() == array_type )
+                {
+                    current_p_->get_array().emplace_back( std::forward< T >( value ) );
+
+                    return &current_p_->get_array().back(); 
+                }
+
+                assert( current_p_->type() == obj_type );
+
+                return &Config_type::add( current_p_->get_obj(), std::move( name_ ), Value_type( std::forward< T >( value ) ) );
+            }
+    #endif
+
+            Value_type* value_p_;           // this is the object or array that is being created
+            Value_type* current_p_;         // the child object or array that is currently being constructed
+
+            std::vector< Value_type* > stack_;   // previous child objects and arrays
+
+            String_type name_;              // of current name/value pair
+            Name_table< String_type > names_;  // kept across documents when the actions are reused, see Reader
+        };
+
+        inline bool is_space( char c )
+        {
+            if( c == ' ' || ( c >= '\t' && c <= '\r' ) ) return true;
+
+            if( static_cast< unsigned char >( c ) < 0x80 ) return false;
+
+            return std::isspace( static_cast< unsigned char >( c ) ) != 0;  // same test as space_p
+        }
+
+        inline bool is_space( wchar_t c )
+        {
+            if( c == L' ' || ( c >= L'\t' && c <= L'\r' ) ) return true;
+
+            if( c < 0x80 ) return false;
+
+            return std::iswspace( c ) != 0;
+        }
+
+        // a hand-written recursive descent parser that calls the semantic actions directly,
+        // it accepts exactly the same input as the Spirit grammer in json_spirit_reader.cpp and 
+        // reports errors at the same positions, but avoids the grammer construction, 
+        // boost::function calls and backtracking of the Spirit parse
+        //
+        // errors are passed back up the call chain rather than thrown, so that 
+        // failing to read malformed input costs no more than reading good input
+        //
+        // Actions_type is called with the characters of each string, literal and number
+        // as it is parsed, see Semantic_actions above and Event_actions below
+        //
+        template< class Actions_type, class Iter_type >
+        class Json_parser
+        {
+        public:
+
+            typedef Actions_type Semantic_actions_t;
+            typedef typename std::iterator_traits< Iter_type >::value_type Char_type;
+
+            Json_parser( Semantic_actions_t& semantic_actions, Iter_type begin, Iter_type end )
+            :   actions_( semantic_actions )
+            ,   i_( begin )
+            ,   end_( end )
+            ,   error_reason_( 0 )
+            {
+            }
+
+            // on success posn() is the first character after the value, trailing white 
+            // space is not consumed, on failure it is the position of the error 
+            //
+            bool parse()
+            {
+                skip_spaces();
+
+                if( !parse_value() ) return fail( i_, "not a value" );
+
+                return true;
+            }
+
+            Iter_type posn() const
+            {
+                return i_;
+            }
+
+            const char* error_reason() const
+            {
+                return error_reason_;
+            }
+
+        private:
+
+            // the innermost error is the one reported
+            //
+            bool fail( Iter_type posn, const char* reason )
+            {
+                if( error_reason_ == 0 ) 
+                {
+                    i_ = posn;
+                    error_reason_ = reason;
+                }
+
+                return false;
+            }
+
+            bool failed() const
+            {
+                return error_reason_ != 0;
+            }
+
+            void skip_spaces()
+            {
+                while( i_ != end_ && is_space( *i_ ) ) ++i_;
+            }
+
+            bool is_next( char c ) const
+            {
+                return ( i_ != end_ ) && ( *i_ == c );
+            }
+
+            // assumes any white space has been skipped, returns false without consuming 
+            // input or recording an error if there is no value to parse
+            //
+            bool parse_value()
+            {
+                if( i_ == end_ ) return false;
+
+                switch( *i_ )
+                {
+                    case '"': return parse_str();
+                    case '{': return parse_obj();
+                    case '[': return parse_array();
+                    case 't': return parse_literal( "true",  &Semantic_actions_t::new_true );
+                    case 'f': return parse_literal( "false", &Semantic_actions_t::new_false );
+                    case 'n': return parse_literal( "null",  &Semantic_actions_t::new_null );
+                }
+
+                return parse_number();
+            }
+
+            bool parse_obj()
+            {
+                actions_.begin_obj( *i_ );
+
+                ++i_;
+
+                skip_spaces();
+
+                if( parse_pair() )
+                {
+                    while( true )
+                    {
+                        skip_spaces();
+
+                        if( !is_next( ',' ) ) break;
+
+                        const Iter_type comma( i_ );
+
+                        ++i_;
+
+                        skip_spaces();
+
+                        if( !parse_pair() ) return fail( comma, "not an object" );
+                    }
+                }
+
+                if( failed() ) return false;
+
+                if( !is_next( '}' ) ) return fail( i_, "not an object" );
+
+                actions_.end_obj( *i_ );
+
+                ++i_;
+
+                return true;
+            }
+
+            // returns false without recording an error if there is no name to parse
+            //
+            bool parse_pair()
+            {
+                Iter_type str_end;
+
+                if( !find_str_end( str_end ) ) return false;
+
+                actions_.new_name( i_, str_end );
+
+                i_ = str_end;
+
+                skip_spaces();
+
+                if( !is_next( ':' ) ) return fail( i_, "no colon in pair" );
+
+                ++i_;
+
+                skip_spaces();
+
+                if( !parse_value() ) return fail( i_, "not a value" );
+
+                return true;
+            }
+
+            bool parse_array()
+            {
+                actions_.begin_array( *i_ );
+
+                ++i_;
+
+                skip_spaces();
+
+                if( parse_value() )
+                {
+                    while( true )
+                    {
+                        skip_spaces();
+
+                        if( !is_next( ',' ) ) break;
+
+                        const Iter_type comma( i_ );
+
+                        ++i_;
+
+                        skip_spaces();
+
+                        if( !parse_value() ) return fail( comma, "not an array" );
+                    }
+                }
+
+                if( failed() ) return false;
+
+                if( !is_next( ']' ) ) return fail( i_, "not an array" );
+
+                actions_.end_array( *i_ );
+
+                ++i_;
+
+                return true;
+            }
+
+            bool parse_str()
+            {
+                Iter_type str_end;
+
+                if( !find_str_end( str_end ) ) return false;
+
+                actions_.new_str( i_, str_end );
+
+                i_ = str_end;
+
+                return true;
+            }
+
+            // finds the end of the quoted string starting at i_ using the rules of Spirit's 
+            // lex_escape_ch_p, the escape sequences themselves are decoded later by get_str
+            //
+            bool find_str_end( Iter_type& str_end )
+            {
+                if( !is_next( '"' ) ) return false;
+
+                Iter_type i( i_ );
+
+                for( ++i; i != end_; )
+                {
+                    i = find_either( i, end_, '"', '\\' );
+
+                    if( i == end_ ) break;
+
+                    const Char_type c( *i );
+
+                    ++i;
+
+                    if( c == '"' )
+                    {
+                        str_end = i;
+                        return true;
+                    }
+
+                    if( i == end_ ) return false;  // c is a backslash
+
+                    const Char_type c2( *i );
+
+                    ++i;
+
+                    if( c2 == 'x' || c2 == 'X' )
+                    {
+                        // spirit only accepts hex escapes that fit in a signed char, ie. "\x7F" or less
+
+                        if( i == end_ || !is_hex_digit( *i ) ) return false;
+
+                        const bool is_high( hex_to_num( *i ) >= 8 );
+
+                        ++i;
+
+                        if( is_high && i != end_ && is_hex_digit( *i ) ) return false;
+                    }
+                }
+
+                return false;
+            }
+
+            bool parse_literal( const char* c_str, void ( Semantic_actions_t::*action )( Iter_type, Iter_type ) )
+            {
+                Iter_type i( i_ );
+
+                for( ; *c_str != 0; ++c_str, ++i )
+                {
+                    if( i == end_ || *i != *c_str ) return false;
+                }
+
+                ( actions_.*action )( i_, i );
+
+                i_ = i;
+
+                return true;
+            }
+
+            bool parse_number()
+            {
+                internal_::Number number;
+
+                const Iter_type end = internal_::scan_number( i_, end_, number );
+
+                if( number.type_ == internal_::Number::none ) return false;
+
+                actions_.new_number( number );
+
+                i_ = end;
+
+                return true;
+            }
+
+            Json_parser& operator=( const Json_parser& ); // to prevent "assignment operator could not be generated" warning
+
+            Semantic_actions_t& actions_;
+            Iter_type i_;
+            const Iter_type end_;
+            const char* error_reason_;
+        };
+
+        // the semantic actions of read_events(), each string is decoded and passed to the handler 
+        // as it is parsed, so nothing is kept beyond the parser's stack of enclosing arrays and objects
+        //
+        template< class Handler_type, class String_type, class Iter_type >
+        class Event_actions
+        {
+        public:
+
+            typedef typename String_type::value_type Char_type;
+
+            explicit Event_actions( Handler_type& handler )
+            :   handler_( handler )
+            {
+            }
+
+            void begin_obj  ( Char_type ) { handler_.begin_obj();   }
+            void end_obj    ( Char_type ) { handler_.end_obj();     }
+            void begin_array( Char_type ) { handler_.begin_array(); }
+            void end_array  ( Char_type ) { handler_.end_array();   }
+
+            void new_name( Iter_type begin, Iter_type end )
+            {
+                handler_.new_name( get_str< String_type >( begin, end ) );
+            }
+
+            void new_str( Iter_type begin, Iter_type end )
+            {
+                handler_.new_str( get_str< String_type >( begin, end ) );
+            }
+
+            void new_true ( Iter_type, Iter_type ) { handler_.new_bool( true );  }
+            void new_false( Iter_type, Iter_type ) { handler_.new_bool( false ); }
+            void new_null ( Iter_type, Iter_type ) { handler_.new_null();        }
+
+            void new_number( const Number& number )
+            {
+                switch( number.type_ )
+                {
+                    case Number::int64:  handler_.new_int   ( number.int64_  ); break;
+                    case Number::uint64: handler_.new_uint64( number.uint64_ ); break;
+                    case Number::real:   handler_.new_real  ( number.real_   ); break;
+                    default: assert( false );
+                }
+            }
+
+        private:
+
+            Event_actions& operator=( const Event_actions& );
+
+            Handler_type& handler_;
+        };
+
+        template< class String_type, class Iter_type, class Handler_type >
+        bool read_events_range( Iter_type& begin, Iter_type end, Handler_type& handler, Error_position* error )
+        {
+            Event_actions< Handler_type, String_type, Iter_type > actions( handler );
+
+            Json_parser< Event_actions< Handler_type, String_type, Iter_type >, Iter_type > parser( actions, begin, end );
+
+            if( !parser.parse() )
+            {
+                if( error != 0 ) *error = get_error_position( begin, end, parser.posn(), parser.error_reason() );
+
+                return false;
+            }
+
+            begin = parser.posn();
+
+            return true;
+        }
+    }
+
+    template< class Handler >
+    bool read_events( const std::string& s, Handler& handler )
+    {
+        std::string::const_iterator begin = s.begin();
+
+        return internal_::read_events_range< std::string >( begin, s.end(), handler, 0 );
+    }
+
+    template< class Handler >
+    bool read_events( const std::string& s, Handler& handler, Error_position& error )
+    {
+        std::string::const_iterator begin = s.begin();
+
+        return internal_::read_events_range< std::string >( begin, s.end(), handler, &error );
+    }
+
+    template< class Handler >
+    void read_events_or_throw( const std::string& s, Handler& handler )
+    {
+        Error_position error;
+
+        if( !read_events( s, handler, error ) ) throw error;
+    }
+
+    template< class Iter_type, class Handler >
+    bool read_events( Iter_type& begin, Iter_type end, Handler& handler )
+    {
+        typedef std::basic_string< typename std::iterator_traits< Iter_type >::value_type > String_type;
+
+        return internal_::read_events_range< String_type >( begin, end, handler, 0 );
+    }
+
+    template< class Iter_type, class Handler >
+    bool read_events( Iter_type& begin, Iter_type end, Handler& handler, Error_position& error )
+    {
+        typedef std::basic_string< typename std::iterator_traits< Iter_type >::value_type > String_type;
+
+        return internal_::read_events_range< String_type >( begin, end, handler, &error );
+    }
+
+    template< class Iter_type, class Handler >
+    void read_events_or_throw( Iter_type& begin, Iter_type end, Handler& handler )
+    {
+        Error_position error;
+
+        if( !read_events( begin, end, handler, error ) ) throw error;
+    }
+
+#ifndef BOOST_NO_STD_WSTRING
+    template< class Handler >
+    bool read_events( const std::wstring& s, Handler& handler )
+    {
+        std::wstring::const_iterator begin = s.begin();
+
+        return internal_::read_events_range< std::wstring >( begin, s.end(), handler, 0 );
+    }
+
+    template< class Handler >
+    bool read_events( const std::wstring& s, Handler& handler, Error_position& error )
+    {
+        std::wstring::const_iterator begin = s.begin();
+
+        return internal_::read_events_range< std::wstring >( begin, s.end(), handler, &error );
+    }
+
+    template< class Handler >
+    void read_events_or_throw( const std::wstring& s, Handler& handler )
+    {
+        Error_position error;
+
+        if( !read_events( s, handler, error ) ) throw error;
+    }
+#endif
+
+    // A Reader reads one value after another, eg. the messages arriving on a connection, keeping 
+    // the memory used by each read for the next, so that reading many small values costs less
+    // than calling read() for each of them, eg.
+    //
+    //    Reader< mValue > reader;
+    //    mValue value;
+    //
+    //    while( receive( message ) )
+    //    {
+    //        reader.parse_or_throw( message, value );
+    //        handle( value );
+    //    }
+    //
+    // The values are the same as those read by read(), for a vValue they refer to the text.
+    // A Reader must only be used by one thread at a time.
+    //
+    template< class Value_type >
+    class Reader
+    {
+    public:
+
+        typedef typename Value_type::Config_type::String_type::value_type Char_type;
+        typedef std::basic_string< Char_type > Text_type;
+
+        bool parse( const Text_type& s, Value_type& value );
+        bool parse( const Text_type& s, Value_type& value, Error_position& error );
+        void parse_or_throw( const Text_type& s, Value_type& value );
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        // temporary text is only accepted by values that do not refer to it, ie. not by vValues
+
+        bool parse( Text_type&& s, Value_type& value );
+        bool parse( Text_type&& s, Value_type& value, Error_position& error );
+        void parse_or_throw( Text_type&& s, Value_type& value );
+#endif
+
+        // on success begin is advanced to the first character after the value
+
+        bool parse( const Char_type*& begin, const Char_type* end, Value_type& value, Error_position& error );
+
+    private:
+
+        typedef internal_::Semantic_actions< Value_type, const Char_type* > Actions_type;
+
+        bool parse_range( const Char_type*& begin, const Char_type* end, Value_type& value, Error_position* error );
+
+        Actions_type actions_;
+    };
+
+    template< class Value_type >
+    bool Reader< Value_type >::parse( const Text_type& s, Value_type& value )
+    {
+        const Char_type* begin = s.data();
+
+        return parse_range( begin, s.data() + s.size(), value, 0 );
+    }
+
+    template< class Value_type >
+    bool Reader< Value_type >::parse( const Text_type& s, Value_type& value, Error_position& error )
+    {
+        const Char_type* begin = s.data();
+
+        return parse_range( begin, s.data() + s.size(), value, &error );
+    }
+
+    template< class Value_type >
+    void Reader< Value_type >::parse_or_throw( const Text_type& s, Value_type& value )
+    {
+        Error_position error;
+
+        if( !parse( s, value, error ) ) throw error;
+    }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+
+    template< class Value_type >
+    bool Reader< Value_type >::parse( Text_type&& s, Value_type& value )
+    {
+        BOOST_STATIC_ASSERT_MSG( !internal_::Refers_to_text< typename Value_type::Config_type::String_type >::value, 
+                                 "the value would refer to a temporary" );
+
+        return parse( static_cast< const Text_type& >( s ), value );
+    }
+
+    template< class Value_type >
+    bool Reader< Value_type >::parse( Text_type&& s, Value_type& value, Error_position& error )
+    {
+        BOOST_STATIC_ASSERT_MSG( !internal_::Refers_to_text< typename Value_type::Config_type::String_type >::value, 
+                                 "the value would refer to a temporary" );
+
+        return parse( static_cast< const Text_type& >( s ), value, error );
+    }
+
+    template< class Value_type >
+    void Reader< Value_type >::parse_or_throw( Text_type&& s, Value_type& value )
+    {
+        BOOST_STATIC_ASSERT_MSG( !internal_::Refers_to_text< typename Value_type::Config_type::String_type >::value, 
+                                 "the value would refer to a temporary" );
+
+        parse_or_throw( static_cast< const Text_type& >( s ), value );
+    }
+
+#endif
+
+    template< class Value_type >
+    bool Reader< Value_type >::parse( const Char_type*& begin, const Char_type* end, Value_type& value, Error_position& error )
+    {
+        return parse_range( begin, end, value, &error );
+    }
+
+    template< class Value_type >
+    bool Reader< Value_type >::parse_range( const Char_type*& begin, const Char_type* end, Value_type& value, Error_position* error )
+    {
+        actions_.reset( value );
+
+        internal_::Json_parser< Actions_type, const Char_type* > parser( actions_, begin, end );
+
+        if( !parser.parse() )
+        {
+            if( error != 0 ) *error = internal_::get_error_position( begin, end, parser.posn(), parser.error_reason() );
+
+            return false;
+        }
+
+        begin = parser.posn();
+
+        return true;
+    }
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef JASON_SPIRIT_SIMD
+#define JASON_SPIRIT_SIMD
+
+//          Copyright John W. Wilkinson 2007 - 2009.
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+// json spirit version 4.02
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+// the instruction sets the reader and the structural index may use, and the bit scan both need
+
+#include <boost/cstdint.hpp>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+    #define JSON_SPIRIT_SSE2
+    #include <emmintrin.h>
+#endif
+
+#if defined( __AVX2__ )
+    #define JSON_SPIRIT_AVX2
+    #include <immintrin.h>
+#endif
+
+#if defined( _MSC_VER )
+    #include <intrin.h>
+#endif
+
+namespace json_spirit
+{
+    namespace internal_
+    {
+        // the position of the lowest set bit of x, x must not be zero
+        //
+        inline unsigned int trailing_zeros( boost::uint64_t x )
+        {
+#if defined( _MSC_VER ) && defined( _M_X64 )
+            unsigned long i;
+            _BitScanForward64( &i, x );
+            return i;
+#elif defined( __GNUC__ )
+            return __builtin_ctzll( x );
+#else
+            unsigned int i = 0;
+            for( ; ( x & 1 ) == 0; x >>= 1 ) ++i;
+            return i;
+#endif
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,231 @@
+#ifndef JASON_SPIRIT_STRING_VIEW
+#define JASON_SPIRIT_STRING_VIEW
+
+//          Copyright John W. Wilkinson 2007 - 2009.
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+// json spirit version 4.02
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include <string>
+#include <cstddef>
+#include <algorithm>
+#include <ostream>
+#include <utility>
+#include <boost/config.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace json_spirit
+{
+    // The string type of the "v" configs. A String_view does not own its characters, it refers
+    // to text that must outlive it, eg. the document it was read from. The exception is a string
+    // that had to be decoded because it contained escape sequences, the view then shares
+    // ownership of the decoded copy, see owns_text().
+    //
+    template< class Char >
+    class String_view
+    {
+    public:
+
+        typedef Char                      value_type;
+        typedef std::char_traits< Char >  traits_type;
+        typedef const Char*               const_pointer;
+        typedef const Char*               const_iterator;
+        typedef const Char*               iterator;
+        typedef std::size_t               size_type;
+        typedef std::basic_string< Char > String_type;
+
+        String_view();                                      // empty
+        String_view( const Char* c_str );                   // refers to c_str
+        String_view( const Char* begin, const Char* end );  // refers to the characters in [begin, end)
+        explicit String_view( const String_type& s );       // refers to the characters of s
+
+        static String_view copy_of( const String_type& s );  // owns a copy of s
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        static String_view copy_of( String_type&& s );
+#endif
+
+        const_iterator begin() const;
+        const_iterator end()   const;
+        const Char*    data()  const;
+        size_type      size()  const;
+        size_type      length() const;
+        bool           empty() const;
+        Char operator[]( size_type i ) const;
+
+        String_type str() const;
+
+        bool owns_text() const;
+
+    private:
+
+        const Char* begin_;
+        const Char* end_;
+        boost::shared_ptr< const String_type > text_;  // only set for copies
+    };
+
+    template< class Char >
+    bool operator==( const String_view< Char >& lhs, const String_view< Char >& rhs )
+    {
+        return lhs.size() == rhs.size() && std::equal( lhs.begin(), lhs.end(), rhs.begin() );
+    }
+
+    template< class Char >
+    bool operator!=( const String_view< Char >& lhs, const String_view< Char >& rhs )
+    {
+        return !( lhs == rhs );
+    }
+
+    template< class Char >
+    bool operator<( const String_view< Char >& lhs, const String_view< Char >& rhs )
+    {
+        return std::lexicographical_compare( lhs.begin(), lhs.end(), rhs.begin(), rhs.end() );
+    }
+
+    template< class Char >
+    bool operator==( const String_view< Char >& lhs, const std::basic_string< Char >& rhs )
+    {
+        return lhs == String_view< Char >( rhs );
+    }
+
+    template< class Char >
+    bool operator==( const std::basic_string< Char >& lhs, const String_view< Char >& rhs )
+    {
+        return String_view< Char >( lhs ) == rhs;
+    }
+
+    template< class Char >
+    bool operator!=( const String_view< Char >& lhs, const std::basic_string< Char >& rhs )
+    {
+        return !( lhs == rhs );
+    }
+
+    template< class Char >
+    bool operator!=( const std::basic_string< Char >& lhs, const String_view< Char >& rhs )
+    {
+        return !( lhs == rhs );
+    }
+
+    template< class Char >
+    std::basic_ostream< Char >& operator<<( std::basic_ostream< Char >& os, const String_view< Char >& s )
+    {
+        return os.write( s.data(), static_cast< std::streamsize >( s.size() ) );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // implementation
+
+    template< class Char >
+    String_view< Char >::String_view()
+    :   begin_( 0 )
+    ,   end_( 0 )
+    {
+    }
+
+    template< class Char >
+    String_view< Char >::String_view( const Char* c_str )
+    :   begin_( c_str )
+    ,   end_( c_str + std::char_traits< Char >::length( c_str ) )
+    {
+    }
+
+    template< class Char >
+    String_view< Char >::String_view( const Char* begin, const Char* end )
+    :   begin_( begin )
+    ,   end_( end )
+    {
+    }
+
+    template< class Char >
+    String_view< Char >::String_view( const String_type& s )
+    :   begin_( s.data() )
+    ,   end_( s.data() + s.size() )
+    {
+    }
+
+    template< class Char >
+    String_view< Char > String_view< Char >::copy_of( const String_type& s )
+    {
+        String_view result;
+
+        result.text_.reset( new String_type( s ) );
+        result.begin_ = result.text_->data();
+        result.end_   = result.begin_ + result.text_->size();
+
+        return result;
+    }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    template< class Char >
+    String_view< Char > String_view< Char >::copy_of( String_type&& s )
+    {
+        String_view result;
+
+        result.text_.reset( new String_type( std::move( s ) ) );
+        result.begin_ = result.text_->data();
+        result.end_   = result.begin_ + result.text_->size();
+
+        return result;
+    }
+#endif
+
+    template< class Char >
+    typename String_view< Char >::const_iterator String_view< Char >::begin() const
+    {
+        return begin_;
+    }
+
+    template< class Char >
+    typename String_view< Char >::const_iterator String_view< Char >::end() const
+    {
+        return end_;
+    }
+
+    template< class Char >
+    const Char* String_view< Char >::data() const
+    {
+        return begin_;
+    }
+
+    template< class Char >
+    typename String_view< Char >::size_type String_view< Char >::size() const
+    {
+        return static_cast< size_type >( end_ - begin_ );
+    }
+
+    template< class Char >
+    typename String_view< Char >::size_type String_view< Char >::length() const
+    {
+        return size();
+    }
+
+    template< class Char >
+    bool String_view< Char >::empty() const
+    {
+        return begin_ == end_;
+    }
+
+    template< class Char >
+    Char String_view< Char >::operator[]( size_type i ) const
+    {
+        return begin_[ i ];
+    }
+
+    template< class Char >
+    typename String_view< Char >::String_type String_view< Char >::str() const
+    {
+        return String_type( begin_, end_ );
+    }
+
+    template< class Char >
+    bool String_view< Char >::owns_text() const
+    {
+        return text_.get() != 0;
+    }
+}
+
+#endif
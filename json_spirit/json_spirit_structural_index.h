@@ -0,0 +1,281 @@
+#ifndef JASON_SPIRIT_STRUCTURAL_INDEX
+#define JASON_SPIRIT_STRUCTURAL_INDEX
+
+//          Copyright John W. Wilkinson 2007 - 2009.
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+// json spirit version 4.02
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include "json_spirit_simd.h"
+
+#include <vector>
+#include <cstring>
+#include <boost/cstdint.hpp>
+
+namespace json_spirit
+{
+    namespace internal_
+    {
+        // A first pass over a large document that records the offset of every unescaped quote,
+        // every backslash starting an escape sequence inside a string and every brace, bracket,
+        // colon and comma outside strings. The document is examined 64 characters at a time
+        // using SSE2 or AVX2 where available, the scalar version gives identical results.
+        //
+        // The index only describes the document correctly up to the first syntax error,
+        // it is the parser's job to find that error.
+        //
+        // The index is only used by read_in_parallel, to find where one document ends and the next
+        // begins. The parser does not build values from it: the index has no entries for numbers
+        // or literals, so the parser still walks the text, and reading a document by following the
+        // offsets was measured to be slower than scanning each string a block at a time.
+        //
+        class Structural_index
+        {
+        public:
+
+            typedef boost::uint32_t Offset;
+            typedef std::vector< Offset > Offsets;
+
+            enum Method{ best, scalar, sse2, avx2 };
+
+            // returns false, leaving the index empty, if the document is too large to index
+            // or the requested method is not compiled in
+            //
+            bool build( const char* begin, const char* end, Method method = best );
+
+            const Offsets& offsets() const { return offsets_; }
+
+        private:
+
+            struct Masks
+            {
+                boost::uint64_t quote_;
+                boost::uint64_t backslash_;
+                boost::uint64_t structural_;
+            };
+
+            template< class Classifier >
+            void build_( const char* begin, const char* end );
+
+            void add_block( Offset base, const Masks& masks );
+
+            Offsets offsets_;
+            boost::uint64_t prev_escaped_;      // 1 if the first character of the next block is escaped
+            boost::uint64_t prev_in_string_;    // all ones if the next block starts inside a string
+        };
+
+        // bit i of the result is the xor of bits 0 to i of x
+        //
+        inline boost::uint64_t prefix_xor( boost::uint64_t x )
+        {
+            x ^= x << 1;
+            x ^= x << 2;
+            x ^= x << 4;
+            x ^= x << 8;
+            x ^= x << 16;
+            x ^= x << 32;
+
+            return x;
+        }
+
+        inline bool is_structural( char c )
+        {
+            return c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',';
+        }
+
+        struct Scalar_classifier
+        {
+            template< class Masks >
+            static void classify( const char* p, Masks& masks )
+            {
+                masks.quote_ = masks.backslash_ = masks.structural_ = 0;
+
+                for( int i = 0; i < 64; ++i )
+                {
+                    const boost::uint64_t bit = boost::uint64_t( 1 ) << i;
+
+                    const char c = p[i];
+
+                    if( c == '"' )            masks.quote_      |= bit;
+                    else if( c == '\\' )      masks.backslash_  |= bit;
+                    else if( is_structural( c ) ) masks.structural_ |= bit;
+                }
+            }
+        };
+
+#ifdef JSON_SPIRIT_SSE2
+
+        struct Sse2_classifier
+        {
+            template< class Masks >
+            static void classify( const char* p, Masks& masks )
+            {
+                masks.quote_ = masks.backslash_ = masks.structural_ = 0;
+
+                for( int i = 0; i < 4; ++i )
+                {
+                    const __m128i v = _mm_loadu_si128( reinterpret_cast< const __m128i* >( p + 16 * i ) );
+
+                    const __m128i structural = _mm_or_si128( _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, _mm_set1_epi8( '{' ) ),
+                                                                                         _mm_cmpeq_epi8( v, _mm_set1_epi8( '}' ) ) ),
+                                                                           _mm_or_si128( _mm_cmpeq_epi8( v, _mm_set1_epi8( '[' ) ),
+                                                                                         _mm_cmpeq_epi8( v, _mm_set1_epi8( ']' ) ) ) ),
+                                                             _mm_or_si128( _mm_cmpeq_epi8( v, _mm_set1_epi8( ':' ) ),
+                                                                           _mm_cmpeq_epi8( v, _mm_set1_epi8( ',' ) ) ) );
+
+                    const int shift = 16 * i;
+
+                    masks.quote_      |= boost::uint64_t( static_cast< unsigned int >( _mm_movemask_epi8( _mm_cmpeq_epi8( v, _mm_set1_epi8( '"' ) ) ) ) ) << shift;
+                    masks.backslash_  |= boost::uint64_t( static_cast< unsigned int >( _mm_movemask_epi8( _mm_cmpeq_epi8( v, _mm_set1_epi8( '\\' ) ) ) ) ) << shift;
+                    masks.structural_ |= boost::uint64_t( static_cast< unsigned int >( _mm_movemask_epi8( structural ) ) ) << shift;
+                }
+            }
+        };
+
+#endif
+
+#ifdef JSON_SPIRIT_AVX2
+
+        struct Avx2_classifier
+        {
+            template< class Masks >
+            static void classify( const char* p, Masks& masks )
+            {
+                masks.quote_ = masks.backslash_ = masks.structural_ = 0;
+
+                for( int i = 0; i < 2; ++i )
+                {
+                    const __m256i v = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( p + 32 * i ) );
+
+                    const __m256i structural = _mm256_or_si256( _mm256_or_si256( _mm256_or_si256( _mm256_cmpeq_epi8( v, _mm256_set1_epi8( '{' ) ),
+                                                                                                  _mm256_cmpeq_epi8( v, _mm256_set1_epi8( '}' ) ) ),
+                                                                                 _mm256_or_si256( _mm256_cmpeq_epi8( v, _mm256_set1_epi8( '[' ) ),
+                                                                                                  _mm256_cmpeq_epi8( v, _mm256_set1_epi8( ']' ) ) ) ),
+                                                                _mm256_or_si256( _mm256_cmpeq_epi8( v, _mm256_set1_epi8( ':' ) ),
+                                                                                 _mm256_cmpeq_epi8( v, _mm256_set1_epi8( ',' ) ) ) );
+
+                    const int shift = 32 * i;
+
+                    masks.quote_      |= boost::uint64_t( static_cast< unsigned int >( _mm256_movemask_epi8( _mm256_cmpeq_epi8( v, _mm256_set1_epi8( '"' ) ) ) ) ) << shift;
+                    masks.backslash_  |= boost::uint64_t( static_cast< unsigned int >( _mm256_movemask_epi8( _mm256_cmpeq_epi8( v, _mm256_set1_epi8( '\\' ) ) ) ) ) << shift;
+                    masks.structural_ |= boost::uint64_t( static_cast< unsigned int >( _mm256_movemask_epi8( structural ) ) ) << shift;
+                }
+            }
+        };
+
+#endif
+
+        inline bool Structural_index::build( const char* begin, const char* end, Method method )
+        {
+            offsets_.clear();
+
+            if( static_cast< boost::uint64_t >( end - begin ) >= 0xFFFFFFFFu ) return false;
+
+#ifdef JSON_SPIRIT_AVX2
+            if( method == best || method == avx2 )
+            {
+                build_< Avx2_classifier >( begin, end );
+                return true;
+            }
+#endif
+
+#ifdef JSON_SPIRIT_SSE2
+            if( method == best || method == sse2 )
+            {
+                build_< Sse2_classifier >( begin, end );
+                return true;
+            }
+#endif
+
+            if( method == best || method == scalar )
+            {
+                build_< Scalar_classifier >( begin, end );
+                return true;
+            }
+
+            return false;
+        }
+
+        template< class Classifier >
+        void Structural_index::build_( const char* begin, const char* end )
+        {
+            offsets_.reserve( ( end - begin ) / 8 );
+
+            prev_escaped_   = 0;
+            prev_in_string_ = 0;
+
+            Masks masks;
+
+            const char* p = begin;
+
+            for( ; end - p >= 64; p += 64 )
+            {
+                Classifier::classify( p, masks );
+
+                add_block( static_cast< Offset >( p - begin ), masks );
+            }
+
+            if( p != end )
+            {
+                char last_block[ 64 ];
+
+                std::memset( last_block, ' ', sizeof( last_block ) );
+                std::memcpy( last_block, p, end - p );
+
+                Classifier::classify( last_block, masks );
+
+                add_block( static_cast< Offset >( p - begin ), masks );
+            }
+        }
+
+        inline void Structural_index::add_block( Offset base, const Masks& masks )
+        {
+            // work out which characters are escaped, backslashes are rare in practice so
+            // they are dealt with one at a time
+
+            boost::uint64_t escaped = prev_escaped_;
+
+            prev_escaped_ = 0;
+
+            boost::uint64_t escape_starts = masks.backslash_ & ~escaped;
+
+            while( escape_starts != 0 )
+            {
+                const boost::uint64_t bit = escape_starts & ( 0 - escape_starts );
+
+                if( bit == ( boost::uint64_t( 1 ) << 63 ) )
+                {
+                    prev_escaped_ = 1;
+                    break;
+                }
+
+                escaped |= bit << 1;
+
+                escape_starts &= ~( bit | ( bit << 1 ) );
+            }
+
+            const boost::uint64_t quotes = masks.quote_ & ~escaped;
+
+            const boost::uint64_t in_string = prefix_xor( quotes ) ^ prev_in_string_;  // includes opening quotes
+
+            prev_in_string_ = ( in_string >> 63 ) != 0 ? ~boost::uint64_t( 0 ) : 0;
+
+            boost::uint64_t bits = quotes |
+                                   ( masks.structural_ & ~in_string ) |
+                                   ( masks.backslash_ & ~escaped & in_string );
+
+            while( bits != 0 )
+            {
+                offsets_.push_back( base + trailing_zeros( bits ) );
+
+                bits &= bits - 1;
+            }
+        }
+    }
+}
+
+#endif
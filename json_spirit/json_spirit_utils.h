@@ -11,7 +11,12 @@
 #endif
 
 #include "json_spirit_value.h"
+#include <algorithm>
+#include <cstddef>
 #include <map>
+#include <string>
+#include <vector>
+#include <boost/functional/hash.hpp>
 
 namespace json_spirit
 { 
@@ -56,6 +61,191 @@ namespace json_spirit
 
         return Object_type::value_type::Value_type::null;
     }
+
+    // Finds the members of a vector object by name in constant time, for code that looks up many 
+    // members of the same object, eg.
+    //
+    //    const Object_index< Object > index( obj );
+    //
+    //    addr.road_ = find_value( index, "road" ).get_str();
+    //    addr.town_ = find_value( index, "town" ).get_str();
+    //
+    // The index is built on the first lookup and holds only the positions of the members, so names
+    // are not copied. The object can be changed freely between lookups. The index is rebuilt when
+    // the object's size or storage has changed, the name of each member it finds is compared, and
+    // a name it does not find is looked for in the object, so that a member added, replaced, renamed
+    // or moved since the index was built is found, and causes a rebuild. A name that is not present 
+    // therefore costs as much as find_value() on the object. Like find_value() it finds the first 
+    // member with a name, except that a member renamed to the name of a later one is not seen until 
+    // the index is next rebuilt. The object must outlive the index, and an index must only be used 
+    // by one thread at a time.
+    //
+    template< class Object_type >
+    class Object_index
+    {
+    public:
+
+        typedef typename Object_type::value_type Pair_type;
+        typedef typename Pair_type::Value_type Value_type;
+        typedef typename Pair_type::String_type::value_type Char_type;
+
+        explicit Object_index( const Object_type& obj );
+
+        template< class String_type >
+        const Value_type* find( const String_type& name ) const;  // null if there is no member with the name
+        const Value_type* find( const Char_type* name ) const;
+
+    private:
+
+        typedef typename Object_type::size_type Size_type;
+
+        static const Size_type empty_slot = static_cast< Size_type >( -1 );
+
+        template< class Iter_type >
+        const Value_type* find( Iter_type name_begin, Iter_type name_end ) const;
+
+        template< class Iter_type >
+        const Value_type* find_indexed( Iter_type name_begin, Iter_type name_end ) const;
+
+        template< class Iter_type >
+        static bool is_name( const Pair_type& pair, Iter_type name_begin, Iter_type name_end );
+
+        bool is_current() const;
+        void build() const;
+
+        template< class Iter_type >
+        static std::size_t hash( Iter_type begin, Iter_type end );
+
+        const Object_type& obj_;
+
+        mutable std::vector< Size_type > slots_;  // positions of members, open addressing with linear probing
+        mutable const Pair_type* indexed_data_;   // the object's storage and size when the index was built
+        mutable Size_type indexed_size_;
+    };
+
+    template< class Object_type, class String_type >
+    const typename Object_type::value_type::Value_type& find_value( const Object_index< Object_type >& index, const String_type& name )
+    {
+        const typename Object_type::value_type::Value_type* value = index.find( name );
+
+        return value != 0 ? *value : Object_type::value_type::Value_type::null;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // implementation
+
+    template< class Object_type >
+    Object_index< Object_type >::Object_index( const Object_type& obj )
+    :   obj_( obj )
+    ,   indexed_data_( 0 )
+    ,   indexed_size_( 0 )
+    {
+    }
+
+    template< class Object_type >
+    template< class String_type >
+    const typename Object_index< Object_type >::Value_type* Object_index< Object_type >::find( const String_type& name ) const
+    {
+        return find( name.begin(), name.end() );
+    }
+
+    template< class Object_type >
+    const typename Object_index< Object_type >::Value_type* Object_index< Object_type >::find( const Char_type* name ) const
+    {
+        return find( name, name + std::char_traits< Char_type >::length( name ) );
+    }
+
+    template< class Object_type >
+    template< class Iter_type >
+    const typename Object_index< Object_type >::Value_type* Object_index< Object_type >::find( Iter_type name_begin, Iter_type name_end ) const
+    {
+        if( !is_current() ) build();
+
+        const Value_type* const value = find_indexed( name_begin, name_end );
+
+        if( value != 0 ) return value;
+
+        // the member may have been added, replaced, renamed or moved since the index was built
+
+        for( Size_type i = 0; i < obj_.size(); ++i )
+        {
+            if( is_name( obj_[i], name_begin, name_end ) )
+            {
+                build();
+
+                return find_indexed( name_begin, name_end );
+            }
+        }
+
+        return 0;
+    }
+
+    template< class Object_type >
+    template< class Iter_type >
+    const typename Object_index< Object_type >::Value_type* Object_index< Object_type >::find_indexed( Iter_type name_begin, Iter_type name_end ) const
+    {
+        const std::size_t mask = slots_.size() - 1;
+
+        for( std::size_t i = hash( name_begin, name_end ) & mask; slots_[i] != empty_slot; i = ( i + 1 ) & mask )
+        {
+            const Pair_type& pair = obj_[ slots_[i] ];
+
+            if( is_name( pair, name_begin, name_end ) ) return &pair.value_;
+        }
+
+        return 0;
+    }
+
+    template< class Object_type >
+    template< class Iter_type >
+    bool Object_index< Object_type >::is_name( const Pair_type& pair, Iter_type name_begin, Iter_type name_end )
+    {
+        return Size_type( name_end - name_begin ) == Size_type( pair.name_.end() - pair.name_.begin() ) &&
+               std::equal( name_begin, name_end, pair.name_.begin() );
+    }
+
+    template< class Object_type >
+    bool Object_index< Object_type >::is_current() const
+    {
+        return !slots_.empty() && indexed_size_ == obj_.size() && ( obj_.empty() || indexed_data_ == &obj_[0] );
+    }
+
+    template< class Object_type >
+    void Object_index< Object_type >::build() const
+    {
+        std::size_t nb_slots = 8;
+
+        while( nb_slots < 2 * obj_.size() ) nb_slots *= 2;  // at most half full
+
+        slots_.assign( nb_slots, Size_type( empty_slot ) );
+
+        const std::size_t mask = nb_slots - 1;
+
+        for( Size_type i = 0; i < obj_.size(); ++i )
+        {
+            const Pair_type& pair = obj_[i];
+
+            std::size_t j = hash( pair.name_.begin(), pair.name_.end() ) & mask;
+
+            for( ; slots_[j] != empty_slot; j = ( j + 1 ) & mask )
+            {
+                if( obj_[ slots_[j] ].name_ == pair.name_ ) break;  // a later duplicate, the first is kept
+            }
+
+            if( slots_[j] == empty_slot ) slots_[j] = i;
+        }
+
+        indexed_data_ = obj_.empty() ? 0 : &obj_[0];
+        indexed_size_ = obj_.size();
+    }
+
+    template< class Object_type >
+    template< class Iter_type >
+    std::size_t Object_index< Object_type >::hash( Iter_type begin, Iter_type end )
+    {
+        return boost::hash_range( begin, end );
+    }
 }
 
 #endif
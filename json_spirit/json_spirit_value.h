@@ -10,19 +10,160 @@
 # pragma once
 #endif
 
+#include "json_spirit_arena.h"
+#include "json_spirit_string_view.h"
+#include "json_spirit_interned_string.h"
 #include <vector>
 #include <map>
+#include <memory>
 #include <string>
 #include <cassert>
+#include <utility>
 #include <boost/config.hpp> 
 #include <boost/cstdint.hpp> 
 #include <boost/shared_ptr.hpp> 
 #include <boost/variant.hpp> 
+#include <boost/mpl/has_xxx.hpp> 
 
 namespace json_spirit
 {
     enum Value_type{ obj_type, array_type, str_type, bool_type, int_type, real_type, null_type };
 
+    namespace internal_
+    {
+        // the allocator for a T from an allocator of anything
+
+        template< class Allocator, class T >
+        struct Rebind_alloc
+        {
+#ifndef BOOST_NO_CXX11_ALLOCATOR
+            typedef typename std::allocator_traits< Allocator >::template rebind_alloc< T > type;
+#else
+            typedef typename Allocator::template rebind< T >::other type;
+#endif
+        };
+
+        // the string type with the same characters as String that uses the allocator, only 
+        // standard strings are rebound, other string types, eg. String_view, are used as they are
+
+        template< class String, class Allocator >
+        struct Rebind_string
+        {
+            typedef String type;
+        };
+
+        template< class Char, class Traits, class String_allocator, class Allocator >
+        struct Rebind_string< std::basic_string< Char, Traits, String_allocator >, Allocator >
+        {
+            typedef std::basic_string< Char, Traits, typename Rebind_alloc< Allocator, Char >::type > type;
+        };
+
+        // the allocator of a config, used for the objects and arrays of its values,
+        // configs without an Allocator_type use the heap
+
+        BOOST_MPL_HAS_XXX_TRAIT_DEF( Allocator_type )
+
+        template< class Config, bool = has_Allocator_type< Config >::value >
+        struct Config_allocator
+        {
+            typedef std::allocator< char > type;
+        };
+
+        template< class Config >
+        struct Config_allocator< Config, true >
+        {
+            typedef typename Config::Allocator_type type;
+        };
+
+        // holds the object or array of a value on the heap, like boost::recursive_wrapper, 
+        // except that it is allocated with the config's allocator and moving hands over the 
+        // pointer rather than allocating a copy of the moved contents, so values can be moved 
+        // without allocating or throwing
+        //
+        template< class T, class Allocator >
+        class Recursive_wrapper
+        {
+        public:
+
+            Recursive_wrapper()                                 : p_( create( T() ) ) {}
+            Recursive_wrapper( const T& t )                     : p_( create( t ) ) {}
+            Recursive_wrapper( const Recursive_wrapper& other ) : alloc_( other.alloc_ ), p_( create( other.get() ) ) {}
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+            Recursive_wrapper( T&& t )                          : p_( create( std::move( t ) ) ) {}
+            Recursive_wrapper( Recursive_wrapper&& other ) BOOST_NOEXCEPT : alloc_( other.alloc_ ), p_( other.p_ ) { other.p_ = 0; }
+
+            Recursive_wrapper& operator=( Recursive_wrapper&& other ) BOOST_NOEXCEPT
+            {
+                swap( other );
+
+                return *this;
+            }
+#endif
+
+            ~Recursive_wrapper()
+            {
+                if( p_ == 0 ) return;
+
+                p_->~T();
+                alloc_.deallocate( p_, 1 );
+            }
+
+            Recursive_wrapper& operator=( const Recursive_wrapper& other )
+            {
+                Recursive_wrapper tmp( other );
+
+                swap( tmp );
+
+                return *this;
+            }
+
+            bool operator==( const Recursive_wrapper& other ) const { return get() == other.get(); }
+
+            T&       get()       { return *p_; }
+            const T& get() const { return *p_; }
+
+        private:
+
+            typedef typename Rebind_alloc< Allocator, T >::type Alloc;
+
+#ifdef BOOST_NO_CXX11_RVALUE_REFERENCES
+            T* create( const T& t )
+#else
+            template< class U >
+            T* create( U&& t )
+#endif
+            {
+                T* const p = alloc_.allocate( 1 );
+
+                try
+                {
+#ifdef BOOST_NO_CXX11_RVALUE_REFERENCES
+                    new( p ) T( t );
+#else
+                    new( p ) T( std::forward< U >( t ) );
+#endif
+                }
+                catch( ... )
+                {
+                    alloc_.deallocate( p, 1 );
+                    throw;
+                }
+
+                return p;
+            }
+
+            void swap( Recursive_wrapper& other )
+            {
+                std::swap( alloc_, other.alloc_ );
+                std::swap( p_, other.p_ );
+            }
+
+            Alloc alloc_;  // default constructed, so an arena allocator uses the current arena
+            T* p_;         // only null once moved from
+        };
+    }
+
     template< class Config >    // Config determines whether the value uses std::string or std::wstring and
                                 // whether JSON Objects are represented as vectors or maps
     class Value_impl
@@ -34,6 +175,7 @@ namespace json_spirit
         typedef typename Config::Object_type Object;
         typedef typename Config::Array_type Array;
         typedef typename String_type::const_pointer Const_str_ptr;  // eg const char*
+        typedef typename internal_::Config_allocator< Config >::type Allocator;
 
         Value_impl();  // creates null value
         Value_impl( Const_str_ptr      value ); 
@@ -48,6 +190,16 @@ namespace json_spirit
 
         Value_impl( const Value_impl& other );
 
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        Value_impl( String_type&& value );
+        Value_impl( Object&&      value );
+        Value_impl( Array&&       value );
+
+        Value_impl( Value_impl&& other ) BOOST_NOEXCEPT;  // leaves other null
+
+        Value_impl& operator=( Value_impl&& lhs ) BOOST_NOEXCEPT;
+#endif
+
         bool operator==( const Value_impl& lhs ) const;
 
         Value_impl& operator=( const Value_impl& lhs );
@@ -77,7 +229,7 @@ namespace json_spirit
     private:
 
         typedef boost::variant< String_type, 
-                                boost::recursive_wrapper< Object >, boost::recursive_wrapper< Array >, 
+                                internal_::Recursive_wrapper< Object, Allocator >, internal_::Recursive_wrapper< Array, Allocator >, 
                                 bool, boost::int64_t, double > Variant;
 
         Value_type type_;
@@ -95,20 +247,32 @@ namespace json_spirit
 
         Pair_impl( const String_type& name, const Value_type& value );
 
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        Pair_impl( String_type&& name, Value_type&& value );
+        Pair_impl( Pair_impl&& other ) BOOST_NOEXCEPT;
+        Pair_impl( const Pair_impl& other );
+
+        Pair_impl& operator=( Pair_impl&& lhs );
+        Pair_impl& operator=( const Pair_impl& lhs );
+#endif
+
         bool operator==( const Pair_impl& lhs ) const;
 
         String_type name_;
         Value_type value_;
     };
 
-    template< class String >
+    // the allocator is used for every string, array and object, see json_spirit_arena.h
+
+    template< class String, class Allocator = std::allocator< typename String::value_type > >
     struct Config_vector
     {
-        typedef String String_type;
+        typedef Allocator Allocator_type;
+        typedef typename internal_::Rebind_string< String, Allocator >::type String_type;
         typedef Value_impl< Config_vector > Value_type;
         typedef Pair_impl < Config_vector > Pair_type;
-        typedef std::vector< Value_type > Array_type;
-        typedef std::vector< Pair_type > Object_type;
+        typedef std::vector< Value_type, typename internal_::Rebind_alloc< Allocator, Value_type >::type > Array_type;
+        typedef std::vector< Pair_type,  typename internal_::Rebind_alloc< Allocator, Pair_type  >::type > Object_type;
 
         static Value_type& add( Object_type& obj, const String_type& name, const Value_type& value )
         {
@@ -116,13 +280,24 @@ namespace json_spirit
 
             return obj.back().value_;
         }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        static Value_type& add( Object_type& obj, String_type&& name, Value_type&& value )
+        {
+            obj.emplace_back( std::move( name ), std::move( value ) );
+
+            return obj.back().value_;
+        }
+#endif
+
+        // used by the writer for each member, returning references so that no member is copied
                 
-        static String_type get_name( const Pair_type& pair )
+        static const String_type& get_name( const Pair_type& pair )
         {
             return pair.name_;
         }
                 
-        static Value_type get_value( const Pair_type& pair )
+        static const Value_type& get_value( const Pair_type& pair )
         {
             return pair.value_;
         }
@@ -149,28 +324,99 @@ namespace json_spirit
     typedef wConfig::Array_type  wArray;
 #endif
 
+    // typedefs for values allocated from the current Arena
+
+    typedef Config_vector< std::string, Arena_allocator< char > > aConfig;
+
+    typedef aConfig::Value_type  aValue;
+    typedef aConfig::Pair_type   aPair;
+    typedef aConfig::Object_type aObject;
+    typedef aConfig::Array_type  aArray;
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    typedef Config_vector< std::wstring, Arena_allocator< wchar_t > > waConfig;
+
+    typedef waConfig::Value_type  waValue;
+    typedef waConfig::Pair_type   waPair;
+    typedef waConfig::Object_type waObject;
+    typedef waConfig::Array_type  waArray;
+#endif
+
+    // typedefs for values whose strings refer to the text they were read from,
+    // see json_spirit_string_view.h for the lifetime of their strings
+
+    typedef Config_vector< String_view< char > > vConfig;
+
+    typedef vConfig::Value_type  vValue;
+    typedef vConfig::Pair_type   vPair;
+    typedef vConfig::Object_type vObject;
+    typedef vConfig::Array_type  vArray;
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    typedef Config_vector< String_view< wchar_t > > wvConfig;
+
+    typedef wvConfig::Value_type  wvValue;
+    typedef wvConfig::Pair_type   wvPair;
+    typedef wvConfig::Object_type wvObject;
+    typedef wvConfig::Array_type  wvArray;
+#endif
+
+    // typedefs for values whose member names are interned, see json_spirit_interned_string.h
+
+    typedef Config_vector< Interned_string< char > > iConfig;
+
+    typedef iConfig::Value_type  iValue;
+    typedef iConfig::Pair_type   iPair;
+    typedef iConfig::Object_type iObject;
+    typedef iConfig::Array_type  iArray;
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    typedef Config_vector< Interned_string< wchar_t > > wiConfig;
+
+    typedef wiConfig::Value_type  wiValue;
+    typedef wiConfig::Pair_type   wiPair;
+    typedef wiConfig::Object_type wiObject;
+    typedef wiConfig::Array_type  wiArray;
+#endif
+
     // map objects
 
-    template< class String >
+    template< class String, class Allocator = std::allocator< typename String::value_type > >
     struct Config_map
     {
-        typedef String String_type;
+        typedef Allocator Allocator_type;
+        typedef typename internal_::Rebind_string< String, Allocator >::type String_type;
         typedef Value_impl< Config_map > Value_type;
-        typedef std::vector< Value_type > Array_type;
-        typedef std::map< String_type, Value_type > Object_type;
+        typedef std::vector< Value_type, typename internal_::Rebind_alloc< Allocator, Value_type >::type > Array_type;
+        typedef std::map< String_type, Value_type, std::less< String_type >, 
+                          typename internal_::Rebind_alloc< Allocator, std::pair< const String_type, Value_type > >::type > Object_type;
         typedef typename Object_type::value_type Pair_type;
 
         static Value_type& add( Object_type& obj, const String_type& name, const Value_type& value )
         {
             return obj[ name ] = value;
         }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        static Value_type& add( Object_type& obj, String_type&& name, Value_type&& value )
+        {
+            const typename Object_type::iterator i = obj.lower_bound( name );
+
+            if( i != obj.end() && !obj.key_comp()( name, i->first ) ) return i->second = std::move( value );
+
+            return obj.emplace_hint( i, std::move( name ), std::move( value ) )->second;
+        }
+#endif
                 
-        static String_type get_name( const Pair_type& pair )
+        static const String_type& get_name( const Pair_type& pair )
         {
             return pair.first;
         }
                 
-        static Value_type get_value( const Pair_type& pair )
+        static const Value_type& get_value( const Pair_type& pair )
         {
             return pair.second;
         }
@@ -194,6 +440,24 @@ namespace json_spirit
     typedef wmConfig::Object_type wmObject;
     typedef wmConfig::Array_type  wmArray;
 
+#endif
+
+    // typedefs for values allocated from the current Arena
+
+    typedef Config_map< std::string, Arena_allocator< char > > amConfig;
+
+    typedef amConfig::Value_type  amValue;
+    typedef amConfig::Object_type amObject;
+    typedef amConfig::Array_type  amArray;
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    typedef Config_map< std::wstring, Arena_allocator< wchar_t > > wamConfig;
+
+    typedef wamConfig::Value_type  wamValue;
+    typedef wamConfig::Object_type wamObject;
+    typedef wamConfig::Array_type  wamArray;
+
 #endif
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -290,6 +554,60 @@ namespace json_spirit
     {
     }
 
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+
+    template< class Config >
+    Value_impl< Config >::Value_impl( String_type&& value )
+    :   type_( str_type )
+    ,   v_( std::move( value ) )
+    ,   is_uint64_( false )
+    {
+    }
+
+    template< class Config >
+    Value_impl< Config >::Value_impl( Object&& value )
+    :   type_( obj_type )
+    ,   v_( std::move( value ) )
+    ,   is_uint64_( false )
+    {
+    }
+
+    template< class Config >
+    Value_impl< Config >::Value_impl( Array&& value )
+    :   type_( array_type )
+    ,   v_( std::move( value ) )
+    ,   is_uint64_( false )
+    {
+    }
+
+    // moving takes over the object or array of other without allocating, see Recursive_wrapper, 
+    // so vectors of values move rather than copy their elements when they grow
+    //
+    template< class Config >
+    Value_impl< Config >::Value_impl( Value_impl< Config >&& other ) BOOST_NOEXCEPT
+    :   type_( other.type() )
+    ,   v_( std::move( other.v_ ) )
+    ,   is_uint64_( other.is_uint64_ )
+    {
+        other.type_      = null_type;
+        other.v_         = String_type();
+        other.is_uint64_ = false;
+    }
+
+    template< class Config >
+    Value_impl< Config >& Value_impl< Config >::operator=( Value_impl&& lhs ) BOOST_NOEXCEPT
+    {
+        Value_impl tmp( std::move( lhs ) );
+
+        std::swap( type_, tmp.type_ );
+        std::swap( v_, tmp.v_ );
+        std::swap( is_uint64_, tmp.is_uint64_ );
+
+        return *this;
+    }
+
+#endif
+
     template< class Config >
     Value_impl< Config >& Value_impl< Config >::operator=( const Value_impl& lhs )
     {
@@ -343,7 +661,7 @@ namespace json_spirit
     {
         assert( type() == obj_type );
 
-        return *boost::get< Object >( &v_ );
+        return boost::get< internal_::Recursive_wrapper< Object, Allocator > >( &v_ )->get();
     }
      
     template< class Config >
@@ -351,7 +669,7 @@ namespace json_spirit
     {
         assert( type() == array_type );
 
-        return *boost::get< Array >( &v_ );
+        return boost::get< internal_::Recursive_wrapper< Array, Allocator > >( &v_ )->get();
     }
      
     template< class Config >
@@ -405,7 +723,7 @@ namespace json_spirit
     {
         assert( type() == obj_type );
 
-        return *boost::get< Object >( &v_ );
+        return boost::get< internal_::Recursive_wrapper< Object, Allocator > >( &v_ )->get();
     }
 
     template< class Config >
@@ -413,7 +731,7 @@ namespace json_spirit
     {
         assert( type() == array_type );
 
-        return *boost::get< Array >( &v_ );
+        return boost::get< internal_::Recursive_wrapper< Array, Allocator > >( &v_ )->get();
     }
 
     template< class Config >
@@ -423,6 +741,49 @@ namespace json_spirit
     {
     }
 
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+
+    template< class Config >
+    Pair_impl< Config >::Pair_impl( String_type&& name, Value_type&& value )
+    :   name_( std::move( name ) )
+    ,   value_( std::move( value ) )
+    {
+    }
+
+    template< class Config >
+    Pair_impl< Config >::Pair_impl( Pair_impl< Config >&& other ) BOOST_NOEXCEPT
+    :   name_( std::move( other.name_ ) )
+    ,   value_( std::move( other.value_ ) )
+    {
+    }
+
+    template< class Config >
+    Pair_impl< Config >::Pair_impl( const Pair_impl< Config >& other )
+    :   name_( other.name_ )
+    ,   value_( other.value_ )
+    {
+    }
+
+    template< class Config >
+    Pair_impl< Config >& Pair_impl< Config >::operator=( Pair_impl&& lhs )
+    {
+        name_  = std::move( lhs.name_ );
+        value_ = std::move( lhs.value_ );
+
+        return *this;
+    }
+
+    template< class Config >
+    Pair_impl< Config >& Pair_impl< Config >::operator=( const Pair_impl& lhs )
+    {
+        name_  = lhs.name_;
+        value_ = lhs.value_;
+
+        return *this;
+    }
+
+#endif
+
     template< class Config >
     bool Pair_impl< Config >::operator==( const Pair_impl< Config >& lhs ) const
     {
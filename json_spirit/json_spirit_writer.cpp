@@ -6,9 +6,14 @@
 #include "json_spirit_writer.h"
 #include "json_spirit_value.h"
 
+#include <algorithm>
 #include <cassert>
-#include <sstream>
-#include <iomanip>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwctype>
+#include <boost/cstdint.hpp>
 
 using namespace json_spirit;
 using namespace std;
@@ -26,307 +31,1408 @@ namespace
         return 'A' - 10 + ch;
     }
 
-    template< class String_type >
-    String_type non_printable_to_string( unsigned int c )
+    // the Generator appends its output to a std::basic_string, or to a Stream_buffer when
+    // writing to a stream, both have the push_back() and append() used below
+    //
+    template< class Buffer_type, class Char_type >
+    void append_ascii( Buffer_type& buf, const char* c_str )
     {
-        typedef typename String_type::value_type Char_type;
-
-        String_type result( 6, '\\' );
+        for( ; *c_str != 0; ++c_str )
+        {
+            buf.push_back( static_cast< Char_type >( *c_str ) );
+        }
+    }
 
-        result[1] = 'u';
+    template< class Buffer_type, class Char_type >
+    void append_non_printable( Buffer_type& buf, unsigned int c )
+    {
+        Char_type result[ 6 ];
 
+        result[ 0 ] = '\\';
+        result[ 1 ] = 'u';
         result[ 5 ] = to_hex_char( c & 0x000F ); c >>= 4;
         result[ 4 ] = to_hex_char( c & 0x000F ); c >>= 4;
         result[ 3 ] = to_hex_char( c & 0x000F ); c >>= 4;
         result[ 2 ] = to_hex_char( c & 0x000F );
 
-        return result;
+        buf.append( result, 6 );
     }
 
-    template< typename Char_type, class String_type >
-    bool add_esc_char( Char_type c, String_type& s )
+    template< class Buffer_type, class Char_type >
+    bool add_esc_char( Char_type c, Buffer_type& buf )
     {
+        const char* esc = 0;
+
         switch( c )
         {
-            case '"':  s += to_str< String_type >( "\\\"" ); return true;
-            case '\\': s += to_str< String_type >( "\\\\" ); return true;
-            case '\b': s += to_str< String_type >( "\\b"  ); return true;
-            case '\f': s += to_str< String_type >( "\\f"  ); return true;
-            case '\n': s += to_str< String_type >( "\\n"  ); return true;
-            case '\r': s += to_str< String_type >( "\\r"  ); return true;
-            case '\t': s += to_str< String_type >( "\\t"  ); return true;
+            case '"':  esc = "\\\""; break;
+            case '\\': esc = "\\\\"; break;
+            case '\b': esc = "\\b";  break;
+            case '\f': esc = "\\f";  break;
+            case '\n': esc = "\\n";  break;
+            case '\r': esc = "\\r";  break;
+            case '\t': esc = "\\t";  break;
+            default: return false;
         }
 
-        return false;
+        buf.push_back( '\\' );
+        buf.push_back( static_cast< Char_type >( esc[1] ) );
+
+        return true;
     }
 
-    template< class String_type >
-    String_type add_esc_chars( const String_type& s )
+    template< class Char_type >
+    bool is_plain_ascii( Char_type c )
     {
-        typedef typename String_type::const_iterator Iter_type;
-        typedef typename String_type::value_type     Char_type;
+        return c >= 0x20 && c < 0x7F && c != '"' && c != '\\';
+    }
 
-        String_type result;
+    // appends s with its special characters escaped, runs of characters that need no
+    // escaping are appended in one go, iswprint() is only consulted for the others
+    //
+    template< class Buffer_type, class String_type >
+    void add_esc_chars( const String_type& s, Buffer_type& buf )
+    {
+        typedef typename String_type::value_type Char_type;
 
-        const Iter_type end( s.end() );
+        const Char_type* i   = s.data();
+        const Char_type* end = i + s.size();
 
-        for( Iter_type i = s.begin(); i != end; ++i )
+        while( i != end )
         {
-            const Char_type c( *i );
+            const Char_type* run_end = i;
+
+            while( run_end != end && is_plain_ascii( *run_end ) ) ++run_end;
+
+            if( run_end != i )
+            {
+                buf.append( i, run_end - i );
+
+                i = run_end;
+
+                if( i == end ) break;
+            }
 
-            if( add_esc_char( c, result ) ) continue;
+            const Char_type c( *i++ );
+
+            if( add_esc_char( c, buf ) ) continue;
 
             const wint_t unsigned_c( ( c >= 0 ) ? c : 256 + c );
 
             if( iswprint( unsigned_c ) )
             {
-                result += c;
+                buf.push_back( c );
             }
             else
             {
-                result += non_printable_to_string< String_type >( unsigned_c );
+                append_non_printable< Buffer_type, Char_type >( buf, unsigned_c );
             }
         }
+    }
 
-        return result;
+    // the digits of n, written backwards from the end of a buffer of at least 20 characters,
+    // returns the position of the first digit
+    //
+    template< class Char_type >
+    Char_type* uint64_to_chars( boost::uint64_t n, Char_type* end )
+    {
+        Char_type* p = end;
+
+        do
+        {
+            *--p = static_cast< Char_type >( '0' + n % 10 );
+
+            n /= 10;
+        }
+        while( n != 0 );
+
+        return p;
     }
 
-    // this class generates the JSON text,
-    // it keeps track of the indentation level etc.
+    // formats a real as a stream would with showpoint and setprecision( 16 ), whatever the 
+    // global C locale is, this is the format used by default before version 4.03
     //
-    template< class Value_type, class Ostream_type >
-    class Generator
+    template< class Buffer_type, class Char_type >
+    void append_legacy_real( Buffer_type& buf, double d )
     {
-        typedef typename Value_type::Config_type Config_type;
-        typedef typename Config_type::String_type String_type;
-        typedef typename Config_type::Object_type Object_type;
-        typedef typename Config_type::Array_type Array_type;
-        typedef typename String_type::value_type Char_type;
-        typedef typename Object_type::value_type Obj_member_type;
+        char result[ 32 ];
 
-    public:
+        const int length = sprintf( result, "%#.16g", d );
 
-        Generator( const Value_type& value, Ostream_type& os, bool pretty )
-        :   os_( os )
-        ,   indentation_level_( 0 )
-        ,   pretty_( pretty )
+        for( int i = 0; i < length; ++i )
         {
-            output( value );
+            const char c = result[i];
+
+            const bool is_decimal_point = !isdigit( static_cast< unsigned char >( c ) ) && c != '-' && c != '+'
+                                           && c != 'e' && c != 'i' && c != 'n' && c != 'f' && c != 'a';
+
+            buf.push_back( static_cast< Char_type >( is_decimal_point ? '.' : c ) );
         }
+    }
 
-    private:
+    // Shortest round trip formatting of reals, using Florian Loitsch's Grisu3 algorithm,
+    // see "Printing Floating-Point Numbers Quickly and Accurately with Integers", PLDI 2010.
+    // Grisu3 either produces the shortest digits that read back as the same double, choosing
+    // the closest to it when there are several, or reports that it cannot be sure of them. 
+    // It gives up on about half a percent of doubles, their digits are found more slowly by 
+    // trying each number of digits in turn, so the output is always the shortest.
 
-        void output( const Value_type& value )
+    // a floating point number with a 64 bit significand, f * 2^e
+
+    struct Diy_fp
+    {
+        Diy_fp( boost::uint64_t f, int e )
+        :   f_( f )
+        ,   e_( e )
         {
-            switch( value.type() )
-            {
-                case obj_type:   output( value.get_obj() );   break;
-                case array_type: output( value.get_array() ); break;
-                case str_type:   output( value.get_str() );   break;
-                case bool_type:  output( value.get_bool() );  break;
-                case int_type:   output_int( value );         break;
-                case real_type:  os_ << showpoint << setprecision( 16 ) 
-                                     << value.get_real();     break;
-                case null_type:  os_ << "null";               break;
-                default: assert( false );
-            }
         }
 
-        void output( const Object_type& obj )
+        Diy_fp operator-( const Diy_fp& rhs ) const
         {
-            output_array_or_obj( obj, '{', '}' );
+            assert( e_ == rhs.e_ && f_ >= rhs.f_ );
+
+            return Diy_fp( f_ - rhs.f_, e_ );
         }
 
-        void output( const Array_type& arr )
+        // the upper 64 bits of the 128 bit product, rounded
+
+        Diy_fp operator*( const Diy_fp& rhs ) const
         {
-            output_array_or_obj( arr, '[', ']' );
+            const boost::uint64_t m32 = 0xFFFFFFFF;
+
+            const boost::uint64_t a = f_ >> 32;
+            const boost::uint64_t b = f_ & m32;
+            const boost::uint64_t c = rhs.f_ >> 32;
+            const boost::uint64_t d = rhs.f_ & m32;
+
+            const boost::uint64_t ac = a * c;
+            const boost::uint64_t bc = b * c;
+            const boost::uint64_t ad = a * d;
+            const boost::uint64_t bd = b * d;
+
+            const boost::uint64_t tmp = ( bd >> 32 ) + ( ad & m32 ) + ( bc & m32 ) + ( 1U << 31 );
+
+            return Diy_fp( ac + ( ad >> 32 ) + ( bc >> 32 ) + ( tmp >> 32 ), e_ + rhs.e_ + 64 );
         }
 
-        void output( const Obj_member_type& member )
+        boost::uint64_t f_;
+        int e_;
+    };
+
+    const int             dp_significand_size = 52;
+    const int             dp_exponent_bias    = 0x3FF + dp_significand_size;
+    const boost::uint64_t dp_hidden_bit       = UINT64_C( 0x0010000000000000 );
+
+    Diy_fp to_diy_fp( double d )
+    {
+        boost::uint64_t bits;
+
+        memcpy( &bits, &d, sizeof( bits ) );
+
+        const int biased_e = static_cast< int >( ( bits >> dp_significand_size ) & 0x7FF );
+
+        const boost::uint64_t significand = bits & ( dp_hidden_bit - 1 );
+
+        if( biased_e != 0 ) return Diy_fp( significand + dp_hidden_bit, biased_e - dp_exponent_bias );
+
+        return Diy_fp( significand, 1 - dp_exponent_bias );  // denormal
+    }
+
+    Diy_fp normalize( Diy_fp x )
+    {
+        while( ( x.f_ & ( UINT64_C( 1 ) << 63 ) ) == 0 )
         {
-            output( Config_type::get_name( member ) ); space(); 
-            os_ << ':'; space(); 
-            output( Config_type::get_value( member ) );
+            x.f_ <<= 1;
+            x.e_--;
         }
 
-        void output_int( const Value_type& value )
+        return x;
+    }
+
+    // the boundaries m- and m+ of v, half way to its neighbouring doubles, both with the
+    // exponent of the normalized m+
+
+    void normalized_boundaries( const Diy_fp& v, Diy_fp& minus, Diy_fp& plus )
+    {
+        plus = normalize( Diy_fp( ( v.f_ << 1 ) + 1, v.e_ - 1 ) );
+
+        // the lower neighbour is closer when v is a power of two
+
+        minus = ( v.f_ == dp_hidden_bit ) ? Diy_fp( ( v.f_ << 2 ) - 1, v.e_ - 2 )
+                                          : Diy_fp( ( v.f_ << 1 ) - 1, v.e_ - 1 );
+
+        minus.f_ <<= minus.e_ - plus.e_;
+        minus.e_ = plus.e_;
+    }
+
+    // 10^k for k = -348, -340, ..., 340, normalized
+
+    struct Cached_power
+    {
+        boost::uint64_t f_;
+        int e_;
+    };
+
+    const Cached_power cached_powers[] =
+    {
+            { UINT64_C( 0xfa8fd5a0081c0288 ), -1220 }, { UINT64_C( 0xbaaee17fa23ebf76 ), -1193 }, { UINT64_C( 0x8b16fb203055ac76 ), -1166 },
+            { UINT64_C( 0xcf42894a5dce35ea ), -1140 }, { UINT64_C( 0x9a6bb0aa55653b2d ), -1113 }, { UINT64_C( 0xe61acf033d1a45df ), -1087 },
+            { UINT64_C( 0xab70fe17c79ac6ca ), -1060 }, { UINT64_C( 0xff77b1fcbebcdc4f ), -1034 }, { UINT64_C( 0xbe5691ef416bd60c ), -1007 },
+            { UINT64_C( 0x8dd01fad907ffc3c ),  -980 }, { UINT64_C( 0xd3515c2831559a83 ),  -954 }, { UINT64_C( 0x9d71ac8fada6c9b5 ),  -927 },
+            { UINT64_C( 0xea9c227723ee8bcb ),  -901 }, { UINT64_C( 0xaecc49914078536d ),  -874 }, { UINT64_C( 0x823c12795db6ce57 ),  -847 },
+            { UINT64_C( 0xc21094364dfb5637 ),  -821 }, { UINT64_C( 0x9096ea6f3848984f ),  -794 }, { UINT64_C( 0xd77485cb25823ac7 ),  -768 },
+            { UINT64_C( 0xa086cfcd97bf97f4 ),  -741 }, { UINT64_C( 0xef340a98172aace5 ),  -715 }, { UINT64_C( 0xb23867fb2a35b28e ),  -688 },
+            { UINT64_C( 0x84c8d4dfd2c63f3b ),  -661 }, { UINT64_C( 0xc5dd44271ad3cdba ),  -635 }, { UINT64_C( 0x936b9fcebb25c996 ),  -608 },
+            { UINT64_C( 0xdbac6c247d62a584 ),  -582 }, { UINT64_C( 0xa3ab66580d5fdaf6 ),  -555 }, { UINT64_C( 0xf3e2f893dec3f126 ),  -529 },
+            { UINT64_C( 0xb5b5ada8aaff80b8 ),  -502 }, { UINT64_C( 0x87625f056c7c4a8b ),  -475 }, { UINT64_C( 0xc9bcff6034c13053 ),  -449 },
+            { UINT64_C( 0x964e858c91ba2655 ),  -422 }, { UINT64_C( 0xdff9772470297ebd ),  -396 }, { UINT64_C( 0xa6dfbd9fb8e5b88f ),  -369 },
+            { UINT64_C( 0xf8a95fcf88747d94 ),  -343 }, { UINT64_C( 0xb94470938fa89bcf ),  -316 }, { UINT64_C( 0x8a08f0f8bf0f156b ),  -289 },
+            { UINT64_C( 0xcdb02555653131b6 ),  -263 }, { UINT64_C( 0x993fe2c6d07b7fac ),  -236 }, { UINT64_C( 0xe45c10c42a2b3b06 ),  -210 },
+            { UINT64_C( 0xaa242499697392d3 ),  -183 }, { UINT64_C( 0xfd87b5f28300ca0e ),  -157 }, { UINT64_C( 0xbce5086492111aeb ),  -130 },
+            { UINT64_C( 0x8cbccc096f5088cc ),  -103 }, { UINT64_C( 0xd1b71758e219652c ),   -77 }, { UINT64_C( 0x9c40000000000000 ),   -50 },
+            { UINT64_C( 0xe8d4a51000000000 ),   -24 }, { UINT64_C( 0xad78ebc5ac620000 ),     3 }, { UINT64_C( 0x813f3978f8940984 ),    30 },
+            { UINT64_C( 0xc097ce7bc90715b3 ),    56 }, { UINT64_C( 0x8f7e32ce7bea5c70 ),    83 }, { UINT64_C( 0xd5d238a4abe98068 ),   109 },
+            { UINT64_C( 0x9f4f2726179a2245 ),   136 }, { UINT64_C( 0xed63a231d4c4fb27 ),   162 }, { UINT64_C( 0xb0de65388cc8ada8 ),   189 },
+            { UINT64_C( 0x83c7088e1aab65db ),   216 }, { UINT64_C( 0xc45d1df942711d9a ),   242 }, { UINT64_C( 0x924d692ca61be758 ),   269 },
+            { UINT64_C( 0xda01ee641a708dea ),   295 }, { UINT64_C( 0xa26da3999aef774a ),   322 }, { UINT64_C( 0xf209787bb47d6b85 ),   348 },
+            { UINT64_C( 0xb454e4a179dd1877 ),   375 }, { UINT64_C( 0x865b86925b9bc5c2 ),   402 }, { UINT64_C( 0xc83553c5c8965d3d ),   428 },
+            { UINT64_C( 0x952ab45cfa97a0b3 ),   455 }, { UINT64_C( 0xde469fbd99a05fe3 ),   481 }, { UINT64_C( 0xa59bc234db398c25 ),   508 },
+            { UINT64_C( 0xf6c69a72a3989f5c ),   534 }, { UINT64_C( 0xb7dcbf5354e9bece ),   561 }, { UINT64_C( 0x88fcf317f22241e2 ),   588 },
+            { UINT64_C( 0xcc20ce9bd35c78a5 ),   614 }, { UINT64_C( 0x98165af37b2153df ),   641 }, { UINT64_C( 0xe2a0b5dc971f303a ),   667 },
+            { UINT64_C( 0xa8d9d1535ce3b396 ),   694 }, { UINT64_C( 0xfb9b7cd9a4a7443c ),   720 }, { UINT64_C( 0xbb764c4ca7a44410 ),   747 },
+            { UINT64_C( 0x8bab8eefb6409c1a ),   774 }, { UINT64_C( 0xd01fef10a657842c ),   800 }, { UINT64_C( 0x9b10a4e5e9913129 ),   827 },
+            { UINT64_C( 0xe7109bfba19c0c9d ),   853 }, { UINT64_C( 0xac2820d9623bf429 ),   880 }, { UINT64_C( 0x80444b5e7aa7cf85 ),   907 },
+            { UINT64_C( 0xbf21e44003acdd2d ),   933 }, { UINT64_C( 0x8e679c2f5e44ff8f ),   960 }, { UINT64_C( 0xd433179d9c8cb841 ),   986 },
+            { UINT64_C( 0x9e19db92b4e31ba9 ),  1013 }, { UINT64_C( 0xeb96bf6ebadf77d9 ),  1039 }, { UINT64_C( 0xaf87023b9bf0ee6b ),  1066 }
+    };
+
+    // a cached power c = 10^-k such that the exponent of c * w is in [-60, -32], where e 
+    // is the exponent of w
+
+    Diy_fp get_cached_power( int e, int& k )
+    {
+        const double dk = ( -61 - e ) * 0.30102999566398114 + 347;  // ceil( log10( 2^( -61 - e ) ) ) + 348 
+
+        int ik = static_cast< int >( dk );
+
+        if( dk - ik > 0.0 ) ++ik;
+
+        const unsigned int index = static_cast< unsigned int >( ( ik >> 3 ) + 1 );
+
+        k = -( -348 + static_cast< int >( index << 3 ) );
+
+        return Diy_fp( cached_powers[ index ].f_, cached_powers[ index ].e_ );
+    }
+
+    const boost::uint64_t pow10[] = 
+    {
+        UINT64_C( 1 ), UINT64_C( 10 ), UINT64_C( 100 ), UINT64_C( 1000 ), UINT64_C( 10000 ),
+        UINT64_C( 100000 ), UINT64_C( 1000000 ), UINT64_C( 10000000 ), UINT64_C( 100000000 ), 
+        UINT64_C( 1000000000 ), UINT64_C( 10000000000 ), UINT64_C( 100000000000 ), 
+        UINT64_C( 1000000000000 ), UINT64_C( 10000000000000 ), UINT64_C( 100000000000000 ), 
+        UINT64_C( 1000000000000000 ), UINT64_C( 10000000000000000 ), UINT64_C( 100000000000000000 ),
+        UINT64_C( 1000000000000000000 ), UINT64_C( 10000000000000000000 )
+    };
+
+    // Moves the last digit towards w while the digits stay within the unsafe interval, the 
+    // boundaries widened by the error of the products. Returns false if the digits may not 
+    // be the closest to w, or may lie outside the safe interval, the boundaries narrowed by 
+    // that error, and so may not read back as w. All the distances are from the digits to 
+    // too_high, the upper boundary of the unsafe interval, in units of 10^kappa * 2^e.
+
+    bool round_weed( char* digits, int length, boost::uint64_t distance_too_high_w, boost::uint64_t unsafe_interval, 
+                     boost::uint64_t rest, boost::uint64_t ten_kappa, boost::uint64_t unit )
+    {
+        const boost::uint64_t small_distance = distance_too_high_w - unit;  // to the highest w could be
+        const boost::uint64_t big_distance   = distance_too_high_w + unit;  // to the lowest w could be
+
+        while( rest < small_distance && unsafe_interval - rest >= ten_kappa &&
+               ( rest + ten_kappa < small_distance || small_distance - rest >= rest + ten_kappa - small_distance ) )
         {
-            if( value.is_uint64() )
-            {
-                os_ << value.get_uint64();
-            }
-            else
-            {
-               os_ << value.get_int64();
-            }
+            digits[ length - 1 ]--;
+            rest += ten_kappa;
         }
 
-        void output( const String_type& s )
+        // if w could also be as low as big_distance suggests, lowering the digit again might 
+        // bring it closer, so which digits are closest cannot be known
+
+        if( rest < big_distance && unsafe_interval - rest >= ten_kappa &&
+            ( rest + ten_kappa < big_distance || big_distance - rest > rest + ten_kappa - big_distance ) )
         {
-            os_ << '"' << add_esc_chars( s ) << '"';
+            return false;
         }
 
-        void output( bool b )
+        return 2 * unit <= rest && rest <= unsafe_interval - 4 * unit;
+    }
+
+    int count_decimal_digits( boost::uint32_t n )
+    {
+        int result = 1;
+
+        while( n >= 10 && result < 10 )
         {
-            os_ << to_str< String_type >( b ? "true" : "false" );
+            n /= 10;
+            ++result;
         }
 
-        template< class T >
-        void output_array_or_obj( const T& t, Char_type start_char, Char_type end_char )
-        {
-            os_ << start_char; new_line();
+        return result;
+    }
 
-            ++indentation_level_;
-            
-            for( typename T::const_iterator i = t.begin(); i != t.end(); ++i )
-            {
-                indent(); output( *i );
+    // generates the digits of the upper boundary of the unsafe interval, too_high, stopping as 
+    // soon as they lie within the interval, returns false if the digits cannot be relied on
 
-                typename T::const_iterator next = i;
+    bool digit_gen( const Diy_fp& low, const Diy_fp& w, const Diy_fp& high, char* digits, int& length, int& k )
+    {
+        boost::uint64_t unit = 1;  // the error of each scaled boundary, in units of 2^e
 
-                if( ++next != t.end())
-                {
-                    os_ << ',';
-                }
+        const Diy_fp too_low ( low.f_  - unit, low.e_ );
+        const Diy_fp too_high( high.f_ + unit, high.e_ );
 
-                new_line();
-            }
+        boost::uint64_t unsafe_interval = ( too_high - too_low ).f_;
 
-            --indentation_level_;
+        const Diy_fp one( UINT64_C( 1 ) << -w.e_, w.e_ );
 
-            indent(); os_ << end_char;
-        }
-        
-        void indent()
+        boost::uint32_t integrals   = static_cast< boost::uint32_t >( too_high.f_ >> -one.e_ );
+        boost::uint64_t fractionals = too_high.f_ & ( one.f_ - 1 );
+
+        int kappa = count_decimal_digits( integrals );
+
+        length = 0;
+
+        while( kappa > 0 )
         {
-            if( !pretty_ ) return;
+            const boost::uint32_t divisor = static_cast< boost::uint32_t >( pow10[ kappa - 1 ] );
 
-            for( int i = 0; i < indentation_level_; ++i )
-            { 
-                os_ << "    ";
+            digits[ length++ ] = static_cast< char >( '0' + integrals / divisor );
+
+            integrals %= divisor;
+
+            --kappa;
+
+            const boost::uint64_t rest = ( static_cast< boost::uint64_t >( integrals ) << -one.e_ ) + fractionals;
+
+            if( rest < unsafe_interval )
+            {
+                k += kappa;
+
+                return round_weed( digits, length, ( too_high - w ).f_, unsafe_interval, rest, 
+                                   static_cast< boost::uint64_t >( divisor ) << -one.e_, unit );
             }
         }
 
-        void space()
+        for( ;; )
         {
-            if( pretty_ ) os_ << ' ';
-        }
+            fractionals     *= 10;
+            unit            *= 10;
+            unsafe_interval *= 10;
 
-        void new_line()
-        {
-            if( pretty_ ) os_ << '\n';
-        }
+            digits[ length++ ] = static_cast< char >( '0' + ( fractionals >> -one.e_ ) );
 
-        Generator& operator=( const Generator& ); // to prevent "assignment operator could not be generated" warning
+            fractionals &= one.f_ - 1;
 
-        Ostream_type& os_;
-        int indentation_level_;
-        bool pretty_;
-    };
+            --kappa;
 
-    template< class Value_type, class Ostream_type >
-    void write_( const Value_type& value, Ostream_type& os, bool pretty )
+            if( fractionals < unsafe_interval )
+            {
+                k += kappa;
+
+                return round_weed( digits, length, ( too_high - w ).f_ * unit, unsafe_interval, fractionals, one.f_, unit );
+            }
+        }
+    }
+
+    // the shortest digits of a positive finite d, d = digits * 10^k, at most 17 digits,
+    // returns false for the few doubles whose digits Grisu3 cannot be sure of
+
+    bool grisu3( double d, char* digits, int& length, int& k )
     {
-        Generator< Value_type, Ostream_type >( value, os, pretty );
+        const Diy_fp v = to_diy_fp( d );
+
+        Diy_fp w_minus( 0, 0 );
+        Diy_fp w_plus ( 0, 0 );
+
+        normalized_boundaries( v, w_minus, w_plus );
+
+        const Diy_fp c_mk = get_cached_power( w_plus.e_, k );
+
+        const Diy_fp w  = normalize( v ) * c_mk;
+        const Diy_fp wp = w_plus  * c_mk;
+        const Diy_fp wm = w_minus * c_mk;
+
+        return digit_gen( wm, w, wp, digits, length, k );
     }
 
-    template< class Value_type >
-    typename Value_type::String_type write_( const Value_type& value, bool pretty )
+    // whether m * 10^k reads back as d, the text has no decimal point so the locale does not matter
+
+    bool reads_back_as( boost::uint64_t m, int k, double d )
     {
-        typedef typename Value_type::String_type::value_type Char_type;
+        char text[ 48 ];
 
-        basic_ostringstream< Char_type > os;
+        char* const text_end = text + 24;
 
-        write_( value, os, pretty );
+        char* p = std::copy( uint64_to_chars( m, text_end ), text_end, text );
 
-        return os.str();
+        sprintf( p, "e%d", k );
+
+        return strtod( text, 0 ) == d;
     }
-}
 
-void json_spirit::write( const Value& value, std::ostream& os )
-{
-    write_( value, os, false );
-}
+    // The shortest digits of a positive finite d, d = digits * 10^k, for the doubles Grisu3 gives 
+    // up on. Each number of digits is tried in turn, the digits d rounds to are the closest, but
+    // when d is a power of two the interval of decimals that read back as d is narrower below it
+    // than above, so the digits either side of them may read back as d when they do not.
 
-void json_spirit::write_formatted( const Value& value, std::ostream& os )
-{
-    write_( value, os, true );
-}
+    void shortest_digits_slowly( double d, char* digits, int& length, int& k )
+    {
+        for( int precision = 1; ; ++precision )
+        {
+            char text[ 48 ];
 
-std::string json_spirit::write( const Value& value )
-{
-    return write_( value, false );
-}
+            sprintf( text, "%.*e", precision - 1, d );  // d.ddde+x, the decimal point depends on the locale
 
-std::string json_spirit::write_formatted( const Value& value )
-{
-    return write_( value, true );
-}
+            boost::uint64_t m = 0;
 
-#ifndef BOOST_NO_STD_WSTRING
+            const char* p = text;
 
-void json_spirit::write( const wValue& value, std::wostream& os )
-{
-    write_( value, os, false );
-}
+            for( ; *p != 'e'; ++p )
+            {
+                if( isdigit( static_cast< unsigned char >( *p ) ) ) m = m * 10 + ( *p - '0' );
+            }
 
-void json_spirit::write_formatted( const wValue& value, std::wostream& os )
-{
-    write_( value, os, true );
-}
+            k = atoi( p + 1 ) - ( precision - 1 );
 
-std::wstring json_spirit::write( const wValue&  value )
-{
-    return write_( value, false );
-}
+            const boost::uint64_t candidates[] = { m, m - 1, m + 1 };
 
-std::wstring json_spirit::write_formatted( const wValue&  value )
-{
-    return write_( value, true );
-}
+            for( int i = 0; i < 3; ++i )
+            {
+                if( candidates[i] == 0 || !reads_back_as( candidates[i], k, d ) ) continue;
 
-#endif
+                boost::uint64_t n = candidates[i];
 
-void json_spirit::write( const mValue& value, std::ostream& os )
-{
-    write_( value, os, false );
-}
+                for( ; n % 10 == 0; n /= 10 ) ++k;
 
-void json_spirit::write_formatted( const mValue& value, std::ostream& os )
-{
-    write_( value, os, true );
-}
+                char* const digits_end = digits + 18;
 
-std::string json_spirit::write( const mValue& value )
-{
-    return write_( value, false );
-}
+                const char* const first = uint64_to_chars( n, digits_end );
 
-std::string json_spirit::write_formatted( const mValue& value )
-{
-    return write_( value, true );
-}
+                length = static_cast< int >( digits_end - first );
 
-#ifndef BOOST_NO_STD_WSTRING
+                std::copy( first, static_cast< const char* >( digits_end ), digits );
 
-void json_spirit::write( const wmValue& value, std::wostream& os )
-{
-    write_( value, os, false );
-}
+                return;
+            }
+        }
+    }
 
-void json_spirit::write_formatted( const wmValue& value, std::wostream& os )
-{
-    write_( value, os, true );
-}
+    // writes d as the shortest text that reads back as the same double, as a plain decimal 
+    // number when that is not too long and in exponent form otherwise, there is always a 
+    // decimal point or an exponent so that the text is read back as a real rather than an int
+    //
+    template< class Buffer_type, class Char_type >
+    void append_shortest_real( Buffer_type& buf, double d )
+    {
+        if( d != d || d - d != 0 )  // nan or infinity
+        {
+            append_legacy_real< Buffer_type, Char_type >( buf, d );
 
-std::wstring json_spirit::write( const wmValue&  value )
-{
-    return write_( value, false );
-}
+            return;
+        }
 
-std::wstring json_spirit::write_formatted( const wmValue&  value )
+        char result[ 32 ];
+
+        char* p = result;
+
+        if( d < 0 || ( d == 0 && 1 / d < 0 ) )
+        {
+            *p++ = '-';
+
+            d = -d;
+        }
+
+        char digits[ 18 ] = { '0' };
+
+        int length = 1;
+        int k      = 0;
+
+        if( d != 0 && !grisu3( d, digits, length, k ) )  // Grisu needs a non-zero value
+        {
+            shortest_digits_slowly( d, digits, length, k );
+        }
+
+        const int point = length + k;  // the position of the decimal point relative to the digits 
+
+        if( length <= point && point <= 21 )  // 1234e7 -> 12340000000.0
+        {
+            p = std::copy( digits, digits + length, p );
+            p = std::fill_n( p, point - length, '0' );
+
+            *p++ = '.'; *p++ = '0';
+        }
+        else if( 0 < point && point <= 21 )  // 1234e-2 -> 12.34
+        {
+            p = std::copy( digits, digits + point, p );
+
+            *p++ = '.';
+
+            p = std::copy( digits + point, digits + length, p );
+        }
+        else if( -6 < point && point <= 0 )  // 1234e-6 -> 0.001234
+        {
+            *p++ = '0'; *p++ = '.';
+
+            p = std::fill_n( p, -point, '0' );
+            p = std::copy( digits, digits + length, p );
+        }
+        else  // 1234e30 -> 1.234e33
+        {
+            *p++ = digits[0];
+
+            if( length > 1 )
+            {
+                *p++ = '.';
+
+                p = std::copy( digits + 1, digits + length, p );
+            }
+
+            *p++ = 'e';
+
+            int exponent = point - 1;
+
+            if( exponent < 0 )
+            {
+                *p++ = '-';
+
+                exponent = -exponent;
+            }
+
+            char exponent_digits[ 24 ];
+
+            char* const exponent_end = exponent_digits + 24;
+
+            p = std::copy( uint64_to_chars( static_cast< boost::uint64_t >( exponent ), exponent_end ), exponent_end, p );
+        }
+
+        for( const char* i = result; i != p; ++i )
+        {
+            buf.push_back( static_cast< Char_type >( *i ) );
+        }
+    }
+
+    // this class generates the JSON text,
+    // it keeps track of the indentation level etc.
+    //
+    template< class Value_type, class Buffer_type >
+    class Generator
+    {
+        typedef typename Value_type::Config_type Config_type;
+        typedef typename Config_type::String_type String_type;
+        typedef typename Config_type::Object_type Object_type;
+        typedef typename Config_type::Array_type Array_type;
+        typedef typename String_type::value_type Char_type;
+        typedef typename Object_type::value_type Obj_member_type;
+
+    public:
+
+        Generator( const Value_type& value, Buffer_type& buf, unsigned int options )
+        :   buf_( buf )
+        ,   indentation_level_( 0 )
+        ,   pretty_( ( options & pretty_print ) != 0 )
+        ,   legacy_reals_( ( options & legacy_real_format ) != 0 )
+        {
+            output( value );
+        }
+
+    private:
+
+        void output( const Value_type& value )
+        {
+            switch( value.type() )
+            {
+                case obj_type:   output( value.get_obj() );   break;
+                case array_type: output( value.get_array() ); break;
+                case str_type:   output( value.get_str() );   break;
+                case bool_type:  output( value.get_bool() );  break;
+                case int_type:   output_int( value );         break;
+                case real_type:  output( value.get_real() );  break;
+                case null_type:  append_ascii< Buffer_type, Char_type >( buf_, "null" );          break;
+                default: assert( false );
+            }
+        }
+
+        void output( const Object_type& obj )
+        {
+            output_array_or_obj( obj, '{', '}' );
+        }
+
+        void output( const Array_type& arr )
+        {
+            output_array_or_obj( arr, '[', ']' );
+        }
+
+        void output( const Obj_member_type& member )
+        {
+            output( Config_type::get_name( member ) ); space(); 
+            buf_.push_back( ':' ); space(); 
+            output( Config_type::get_value( member ) );
+        }
+
+        void output_int( const Value_type& value )
+        {
+            Char_type digits[ 24 ];
+
+            Char_type* const end = digits + 24;
+
+            if( value.is_uint64() )
+            {
+                const Char_type* begin = uint64_to_chars( value.get_uint64(), end );
+
+                buf_.append( begin, end - begin );
+            }
+            else
+            {
+                const boost::int64_t i = value.get_int64();
+
+                // negated as unsigned so that the minimum int64 does not overflow
+
+                const boost::uint64_t magnitude = i < 0 ? 0 - static_cast< boost::uint64_t >( i ) 
+                                                        : static_cast< boost::uint64_t >( i );
+
+                Char_type* begin = uint64_to_chars( magnitude, end );
+
+                if( i < 0 ) *--begin = '-';
+
+                buf_.append( begin, end - begin );
+            }
+        }
+
+        void output( const String_type& s )
+        {
+            buf_.push_back( '"' );
+            add_esc_chars( s, buf_ );
+            buf_.push_back( '"' );
+        }
+
+        void output( double d )
+        {
+            if( legacy_reals_ )
+            {
+                append_legacy_real< Buffer_type, Char_type >( buf_, d );
+            }
+            else
+            {
+                append_shortest_real< Buffer_type, Char_type >( buf_, d );
+            }
+        }
+
+        void output( bool b )
+        {
+            append_ascii< Buffer_type, Char_type >( buf_, b ? "true" : "false" );
+        }
+
+        template< class T >
+        void output_array_or_obj( const T& t, Char_type start_char, Char_type end_char )
+        {
+            buf_.push_back( start_char ); new_line();
+
+            ++indentation_level_;
+            
+            for( typename T::const_iterator i = t.begin(); i != t.end(); ++i )
+            {
+                indent(); output( *i );
+
+                typename T::const_iterator next = i;
+
+                if( ++next != t.end())
+                {
+                    buf_.push_back( ',' );
+                }
+
+                new_line();
+            }
+
+            --indentation_level_;
+
+            indent(); buf_.push_back( end_char );
+        }
+        
+        void indent()
+        {
+            if( !pretty_ ) return;
+
+            for( int i = 0; i < indentation_level_; ++i )
+            { 
+                append_ascii< Buffer_type, Char_type >( buf_, "    " );
+            }
+        }
+
+        void space()
+        {
+            if( pretty_ ) buf_.push_back( ' ' );
+        }
+
+        void new_line()
+        {
+            if( pretty_ ) buf_.push_back( '\n' );
+        }
+
+        Generator& operator=( const Generator& ); // to prevent "assignment operator could not be generated" warning
+
+        Buffer_type& buf_;
+        int indentation_level_;
+        bool pretty_;
+        bool legacy_reals_;
+    };
+
+    // adapts a stream for the Generator, the text is collected in a buffer and written to 
+    // the stream a block at a time, so the stream's locale, sentries and virtual functions 
+    // are used once per block rather than once per token
+    //
+    template< class Ostream_type >
+    class Stream_buffer
+    {
+    public:
+
+        typedef typename Ostream_type::char_type Char_type;
+
+        explicit Stream_buffer( Ostream_type& os )
+        :   os_( os )
+        {
+            buf_.reserve( block_size + 64 );
+        }
+
+        void push_back( Char_type c )
+        {
+            buf_.push_back( c );
+
+            if( buf_.size() >= block_size ) flush();
+        }
+
+        void append( const Char_type* s, std::size_t n )
+        {
+            buf_.append( s, n );
+
+            if( buf_.size() >= block_size ) flush();
+        }
+
+        void flush()
+        {
+            os_.write( buf_.data(), static_cast< std::streamsize >( buf_.size() ) );
+
+            buf_.clear();
+        }
+
+    private:
+
+        Stream_buffer& operator=( const Stream_buffer& );
+
+        static const std::size_t block_size = 4096;
+
+        Ostream_type& os_;
+        std::basic_string< Char_type > buf_;
+    };
+
+    template< class Value_type, class Ostream_type >
+    void write_( const Value_type& value, Ostream_type& os, unsigned int options )
+    {
+        Stream_buffer< Ostream_type > buf( os );
+
+        Generator< Value_type, Stream_buffer< Ostream_type > >( value, buf, options );
+
+        buf.flush();
+    }
+
+    template< class Value_type >
+    void write_( const Value_type& value, std::basic_string< typename Value_type::String_type::value_type >& s, unsigned int options )
+    {
+        Generator< Value_type, std::basic_string< typename Value_type::String_type::value_type > >( value, s, options );
+    }
+
+    // the text is returned in a std::string or std::wstring whatever the value's string 
+    // type, so that it can outlive an arena the value was allocated from
+    //
+    template< class Value_type >
+    std::basic_string< typename Value_type::String_type::value_type > write_( const Value_type& value, unsigned int options )
+    {
+        std::basic_string< typename Value_type::String_type::value_type > result;
+
+        write_( value, result, options );
+
+        return result;
+    }
+}
+
+void json_spirit::write( const Value& value, std::ostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const Value& value, std::ostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const Value& value, std::string& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const Value& value, std::string& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::string json_spirit::write( const Value& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::string json_spirit::write_formatted( const Value& value )
+{
+    return write_( value, pretty_print );
+}
+
+#ifndef BOOST_NO_STD_WSTRING
+
+void json_spirit::write( const wValue& value, std::wostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const wValue& value, std::wostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const wValue& value, std::wstring& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const wValue& value, std::wstring& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::wstring json_spirit::write( const wValue& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::wstring json_spirit::write_formatted( const wValue&  value )
+{
+    return write_( value, pretty_print );
+}
+
+#endif
+
+void json_spirit::write( const mValue& value, std::ostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const mValue& value, std::ostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const mValue& value, std::string& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const mValue& value, std::string& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::string json_spirit::write( const mValue& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::string json_spirit::write_formatted( const mValue& value )
+{
+    return write_( value, pretty_print );
+}
+
+#ifndef BOOST_NO_STD_WSTRING
+
+void json_spirit::write( const wmValue& value, std::wostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const wmValue& value, std::wostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const wmValue& value, std::wstring& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const wmValue& value, std::wstring& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::wstring json_spirit::write( const wmValue& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::wstring json_spirit::write_formatted( const wmValue&  value )
+{
+    return write_( value, pretty_print );
+}
+
+#endif
+
+void json_spirit::write( const cValue& value, std::ostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const cValue& value, std::ostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const cValue& value, std::string& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const cValue& value, std::string& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::string json_spirit::write( const cValue& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::string json_spirit::write_formatted( const cValue& value )
+{
+    return write_( value, pretty_print );
+}
+
+#ifndef BOOST_NO_STD_WSTRING
+
+void json_spirit::write( const wcValue& value, std::wostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const wcValue& value, std::wostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const wcValue& value, std::wstring& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const wcValue& value, std::wstring& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::wstring json_spirit::write( const wcValue& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::wstring json_spirit::write_formatted( const wcValue&  value )
+{
+    return write_( value, pretty_print );
+}
+
+#endif
+
+void json_spirit::write( const aValue& value, std::ostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const aValue& value, std::ostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const aValue& value, std::string& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const aValue& value, std::string& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::string json_spirit::write( const aValue& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::string json_spirit::write_formatted( const aValue& value )
+{
+    return write_( value, pretty_print );
+}
+
+#ifndef BOOST_NO_STD_WSTRING
+
+void json_spirit::write( const waValue& value, std::wostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const waValue& value, std::wostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const waValue& value, std::wstring& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const waValue& value, std::wstring& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::wstring json_spirit::write( const waValue& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::wstring json_spirit::write_formatted( const waValue&  value )
+{
+    return write_( value, pretty_print );
+}
+
+#endif
+
+void json_spirit::write( const amValue& value, std::ostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const amValue& value, std::ostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const amValue& value, std::string& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const amValue& value, std::string& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::string json_spirit::write( const amValue& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::string json_spirit::write_formatted( const amValue& value )
+{
+    return write_( value, pretty_print );
+}
+
+#ifndef BOOST_NO_STD_WSTRING
+
+void json_spirit::write( const wamValue& value, std::wostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const wamValue& value, std::wostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const wamValue& value, std::wstring& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const wamValue& value, std::wstring& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::wstring json_spirit::write( const wamValue& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::wstring json_spirit::write_formatted( const wamValue&  value )
+{
+    return write_( value, pretty_print );
+}
+
+#endif
+
+void json_spirit::write( const vValue& value, std::ostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const vValue& value, std::ostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const vValue& value, std::string& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const vValue& value, std::string& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::string json_spirit::write( const vValue& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::string json_spirit::write_formatted( const vValue& value )
+{
+    return write_( value, pretty_print );
+}
+
+#ifndef BOOST_NO_STD_WSTRING
+
+void json_spirit::write( const wvValue& value, std::wostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const wvValue& value, std::wostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const wvValue& value, std::wstring& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const wvValue& value, std::wstring& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::wstring json_spirit::write( const wvValue& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::wstring json_spirit::write_formatted( const wvValue&  value )
+{
+    return write_( value, pretty_print );
+}
+
+#endif
+
+void json_spirit::write( const iValue& value, std::ostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const iValue& value, std::ostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const iValue& value, std::string& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const iValue& value, std::string& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::string json_spirit::write( const iValue& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::string json_spirit::write_formatted( const iValue& value )
+{
+    return write_( value, pretty_print );
+}
+
+#ifndef BOOST_NO_STD_WSTRING
+
+void json_spirit::write( const wiValue& value, std::wostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const wiValue& value, std::wostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const wiValue& value, std::wstring& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const wiValue& value, std::wstring& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::wstring json_spirit::write( const wiValue& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::wstring json_spirit::write_formatted( const wiValue&  value )
+{
+    return write_( value, pretty_print );
+}
+
+#endif
+
+void json_spirit::write( const hValue& value, std::ostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const hValue& value, std::ostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const hValue& value, std::string& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const hValue& value, std::string& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::string json_spirit::write( const hValue& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::string json_spirit::write_formatted( const hValue& value )
+{
+    return write_( value, pretty_print );
+}
+
+#ifndef BOOST_NO_STD_WSTRING
+
+void json_spirit::write( const whValue& value, std::wostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const whValue& value, std::wostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const whValue& value, std::wstring& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const whValue& value, std::wstring& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::wstring json_spirit::write( const whValue& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::wstring json_spirit::write_formatted( const whValue&  value )
+{
+    return write_( value, pretty_print );
+}
+
+#endif
+
+void json_spirit::write( const fValue& value, std::ostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const fValue& value, std::ostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const fValue& value, std::string& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const fValue& value, std::string& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::string json_spirit::write( const fValue& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::string json_spirit::write_formatted( const fValue& value )
+{
+    return write_( value, pretty_print );
+}
+
+#ifndef BOOST_NO_STD_WSTRING
+
+void json_spirit::write( const wfValue& value, std::wostream& os, unsigned int options )
+{
+    write_( value, os, options );
+}
+
+void json_spirit::write_formatted( const wfValue& value, std::wostream& os )
+{
+    write_( value, os, pretty_print );
+}
+
+void json_spirit::write( const wfValue& value, std::wstring& s, unsigned int options )
+{
+    write_( value, s, options );
+}
+
+void json_spirit::write_formatted( const wfValue& value, std::wstring& s )
+{
+    write_( value, s, pretty_print );
+}
+
+std::wstring json_spirit::write( const wfValue& value, unsigned int options )
+{
+    return write_( value, options );
+}
+
+std::wstring json_spirit::write_formatted( const wfValue&  value )
 {
-    return write_( value, true );
+    return write_( value, pretty_print );
 }
 
 #endif
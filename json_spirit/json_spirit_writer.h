@@ -11,38 +11,181 @@
 #endif
 
 #include "json_spirit_value.h"
+#include "json_spirit_compact_value.h"
+#include "json_spirit_hash_object.h"
+#include "json_spirit_flat_object.h"
 #include <iostream>
 
 namespace json_spirit
 {
-    // functions to convert JSON Values to text, 
-    // the "formatted" versions add whitespace to format the output nicely
+    enum Output_options{ pretty_print       = 0x01,   // add whitespace to format the output nicely
+                         legacy_real_format = 0x02 }; // write reals with 16 significant digits and trailing zeros,
+                                                      // rather than the shortest text that reads back as the same value
 
-    void         write          ( const Value& value, std::ostream&  os );
+    // functions to convert JSON Values to text, the options are a combination of the 
+    // Output_options above, the "formatted" versions are the same as using pretty_print,
+    // the versions taking a string append the text to it, so a string can be reused 
+    // to avoid reallocating its buffer
+
+    void         write          ( const Value& value, std::ostream&  os, unsigned int options = 0 );
     void         write_formatted( const Value& value, std::ostream&  os );
-    std::string  write          ( const Value& value );
+    std::string  write          ( const Value& value, unsigned int options = 0 );
     std::string  write_formatted( const Value& value );
+    void         write          ( const Value& value, std::string&  s, unsigned int options = 0 );
+    void         write_formatted( const Value& value, std::string&  s );
 
 #ifndef BOOST_NO_STD_WSTRING
 
-    void         write          ( const wValue& value, std::wostream& os );
+    void         write          ( const wValue& value, std::wostream& os, unsigned int options = 0 );
     void         write_formatted( const wValue& value, std::wostream& os );
-    std::wstring write          ( const wValue& value );
+    std::wstring write          ( const wValue& value, unsigned int options = 0 );
     std::wstring write_formatted( const wValue& value );
+    void         write          ( const wValue& value, std::wstring& s, unsigned int options = 0 );
+    void         write_formatted( const wValue& value, std::wstring& s );
 
 #endif
 
-    void         write          ( const mValue& value, std::ostream&  os );
+    void         write          ( const mValue& value, std::ostream&  os, unsigned int options = 0 );
     void         write_formatted( const mValue& value, std::ostream&  os );
-    std::string  write          ( const mValue& value );
+    std::string  write          ( const mValue& value, unsigned int options = 0 );
     std::string  write_formatted( const mValue& value );
+    void         write          ( const mValue& value, std::string&  s, unsigned int options = 0 );
+    void         write_formatted( const mValue& value, std::string&  s );
 
 #ifndef BOOST_NO_STD_WSTRING
 
-    void         write          ( const wmValue& value, std::wostream& os );
+    void         write          ( const wmValue& value, std::wostream& os, unsigned int options = 0 );
     void         write_formatted( const wmValue& value, std::wostream& os );
-    std::wstring write          ( const wmValue& value );
+    std::wstring write          ( const wmValue& value, unsigned int options = 0 );
     std::wstring write_formatted( const wmValue& value );
+    void         write          ( const wmValue& value, std::wstring& s, unsigned int options = 0 );
+    void         write_formatted( const wmValue& value, std::wstring& s );
+
+#endif
+
+    void         write          ( const cValue& value, std::ostream&  os, unsigned int options = 0 );
+    void         write_formatted( const cValue& value, std::ostream&  os );
+    std::string  write          ( const cValue& value, unsigned int options = 0 );
+    std::string  write_formatted( const cValue& value );
+    void         write          ( const cValue& value, std::string&  s, unsigned int options = 0 );
+    void         write_formatted( const cValue& value, std::string&  s );
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    void         write          ( const wcValue& value, std::wostream& os, unsigned int options = 0 );
+    void         write_formatted( const wcValue& value, std::wostream& os );
+    std::wstring write          ( const wcValue& value, unsigned int options = 0 );
+    std::wstring write_formatted( const wcValue& value );
+    void         write          ( const wcValue& value, std::wstring& s, unsigned int options = 0 );
+    void         write_formatted( const wcValue& value, std::wstring& s );
+
+#endif
+
+    void         write          ( const aValue& value, std::ostream&  os, unsigned int options = 0 );
+    void         write_formatted( const aValue& value, std::ostream&  os );
+    std::string  write          ( const aValue& value, unsigned int options = 0 );
+    std::string  write_formatted( const aValue& value );
+    void         write          ( const aValue& value, std::string&  s, unsigned int options = 0 );
+    void         write_formatted( const aValue& value, std::string&  s );
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    void         write          ( const waValue& value, std::wostream& os, unsigned int options = 0 );
+    void         write_formatted( const waValue& value, std::wostream& os );
+    std::wstring write          ( const waValue& value, unsigned int options = 0 );
+    std::wstring write_formatted( const waValue& value );
+    void         write          ( const waValue& value, std::wstring& s, unsigned int options = 0 );
+    void         write_formatted( const waValue& value, std::wstring& s );
+
+#endif
+
+    void         write          ( const amValue& value, std::ostream&  os, unsigned int options = 0 );
+    void         write_formatted( const amValue& value, std::ostream&  os );
+    std::string  write          ( const amValue& value, unsigned int options = 0 );
+    std::string  write_formatted( const amValue& value );
+    void         write          ( const amValue& value, std::string&  s, unsigned int options = 0 );
+    void         write_formatted( const amValue& value, std::string&  s );
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    void         write          ( const wamValue& value, std::wostream& os, unsigned int options = 0 );
+    void         write_formatted( const wamValue& value, std::wostream& os );
+    std::wstring write          ( const wamValue& value, unsigned int options = 0 );
+    std::wstring write_formatted( const wamValue& value );
+    void         write          ( const wamValue& value, std::wstring& s, unsigned int options = 0 );
+    void         write_formatted( const wamValue& value, std::wstring& s );
+
+#endif
+
+    void         write          ( const vValue& value, std::ostream&  os, unsigned int options = 0 );
+    void         write_formatted( const vValue& value, std::ostream&  os );
+    std::string  write          ( const vValue& value, unsigned int options = 0 );
+    std::string  write_formatted( const vValue& value );
+    void         write          ( const vValue& value, std::string&  s, unsigned int options = 0 );
+    void         write_formatted( const vValue& value, std::string&  s );
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    void         write          ( const wvValue& value, std::wostream& os, unsigned int options = 0 );
+    void         write_formatted( const wvValue& value, std::wostream& os );
+    std::wstring write          ( const wvValue& value, unsigned int options = 0 );
+    std::wstring write_formatted( const wvValue& value );
+    void         write          ( const wvValue& value, std::wstring& s, unsigned int options = 0 );
+    void         write_formatted( const wvValue& value, std::wstring& s );
+
+#endif
+
+    void         write          ( const iValue& value, std::ostream&  os, unsigned int options = 0 );
+    void         write_formatted( const iValue& value, std::ostream&  os );
+    std::string  write          ( const iValue& value, unsigned int options = 0 );
+    std::string  write_formatted( const iValue& value );
+    void         write          ( const iValue& value, std::string&  s, unsigned int options = 0 );
+    void         write_formatted( const iValue& value, std::string&  s );
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    void         write          ( const wiValue& value, std::wostream& os, unsigned int options = 0 );
+    void         write_formatted( const wiValue& value, std::wostream& os );
+    std::wstring write          ( const wiValue& value, unsigned int options = 0 );
+    std::wstring write_formatted( const wiValue& value );
+    void         write          ( const wiValue& value, std::wstring& s, unsigned int options = 0 );
+    void         write_formatted( const wiValue& value, std::wstring& s );
+
+#endif
+
+    void         write          ( const hValue& value, std::ostream&  os, unsigned int options = 0 );
+    void         write_formatted( const hValue& value, std::ostream&  os );
+    std::string  write          ( const hValue& value, unsigned int options = 0 );
+    std::string  write_formatted( const hValue& value );
+    void         write          ( const hValue& value, std::string&  s, unsigned int options = 0 );
+    void         write_formatted( const hValue& value, std::string&  s );
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    void         write          ( const whValue& value, std::wostream& os, unsigned int options = 0 );
+    void         write_formatted( const whValue& value, std::wostream& os );
+    std::wstring write          ( const whValue& value, unsigned int options = 0 );
+    std::wstring write_formatted( const whValue& value );
+    void         write          ( const whValue& value, std::wstring& s, unsigned int options = 0 );
+    void         write_formatted( const whValue& value, std::wstring& s );
+
+#endif
+
+    void         write          ( const fValue& value, std::ostream&  os, unsigned int options = 0 );
+    void         write_formatted( const fValue& value, std::ostream&  os );
+    std::string  write          ( const fValue& value, unsigned int options = 0 );
+    std::string  write_formatted( const fValue& value );
+    void         write          ( const fValue& value, std::string&  s, unsigned int options = 0 );
+    void         write_formatted( const fValue& value, std::string&  s );
+
+#ifndef BOOST_NO_STD_WSTRING
+
+    void         write          ( const wfValue& value, std::wostream& os, unsigned int options = 0 );
+    void         write_formatted( const wfValue& value, std::wostream& os );
+    std::wstring write          ( const wfValue& value, unsigned int options = 0 );
+    std::wstring write_formatted( const wfValue& value );
+    void         write          ( const wfValue& value, std::wstring& s, unsigned int options = 0 );
+    void         write_formatted( const wfValue& value, std::wstring& s );
 
 #endif
 }
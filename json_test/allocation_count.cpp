@@ -0,0 +1,56 @@
+//          Copyright John W. Wilkinson 2007 - 2009.
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+// json spirit version 4.02
+
+#include "allocation_count.h"
+
+#include <cstdlib>
+#include <new>
+#include <boost/config.hpp>
+#include <boost/detail/atomic_count.hpp>
+
+namespace
+{
+    boost::detail::atomic_count nb_allocations_( 0 );
+}
+
+unsigned long nb_allocations()
+{
+    return nb_allocations_;
+}
+
+void* operator new( std::size_t size )
+{
+    ++nb_allocations_;
+
+    void* p = std::malloc( size == 0 ? 1 : size );
+
+    if( p == 0 ) throw std::bad_alloc();
+
+    return p;
+}
+
+void* operator new( std::size_t size, const std::nothrow_t& ) BOOST_NOEXCEPT  // used by std::stable_sort, so must be freed by operator delete below
+{
+    ++nb_allocations_;
+
+    return std::malloc( size == 0 ? 1 : size );
+}
+
+void operator delete( void* p ) BOOST_NOEXCEPT
+{
+    std::free( p );
+}
+
+void operator delete( void* p, const std::nothrow_t& ) BOOST_NOEXCEPT
+{
+    std::free( p );
+}
+
+#ifdef __cpp_sized_deallocation
+void operator delete( void* p, std::size_t ) BOOST_NOEXCEPT
+{
+    std::free( p );
+}
+#endif
@@ -0,0 +1,19 @@
+#ifndef JASON_SPIRIT_TEST_ALLOCATION_COUNT
+#define JASON_SPIRIT_TEST_ALLOCATION_COUNT
+
+//          Copyright John W. Wilkinson 2007 - 2009.
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+// json spirit version 4.02
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+// the number of allocations made so far by the whole test program, on any thread,
+// counted by the replacement operator new in allocation_count.cpp, which is kept
+// in a file of its own so that the compiler does not inline it into its callers
+
+unsigned long nb_allocations();
+
+#endif
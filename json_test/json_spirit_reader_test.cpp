@@ -5,16 +5,33 @@
 
 #include "json_spirit_reader_test.h"
 #include "json_spirit_reader.h"
+#include "json_spirit_reader_template.h"
+#include "json_spirit_cursor.h"
+#include "json_spirit_incremental_reader.h"
 #include "json_spirit_value.h" 
 #include "json_spirit_writer.h" 
+#include "json_spirit_structural_index.h" 
+#include "json_spirit_utils.h"
 #include "utils_test.h"
+#include "allocation_count.h"
 
 #include <limits.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <sstream>
+#include <fstream>
 #include <boost/assign/list_of.hpp>
 #include <boost/timer.hpp>
 #include <boost/lexical_cast.hpp>
 
+#if !defined( BOOST_NO_CXX11_HDR_THREAD ) && \
+    ( !defined( JSON_SPIRIT_USE_SPIRIT_GRAMMER ) || defined( BOOST_SPIRIT_THREADSAFE ) )
+    #define JSON_SPIRIT_TEST_THREADS
+    #include <thread>
+#endif
+
 using namespace json_spirit;
 using namespace std;
 using namespace boost;
@@ -157,6 +174,13 @@ namespace
             test_syntax( INT_MIN, INT_MAX );
             test_syntax( LLONG_MIN, LLONG_MAX );
             test_syntax( "[1 2 3]", false );
+            test_syntax( "[+1, .5, 1., 1.e2, 01]" );
+            test_syntax( "[1e]", false );
+            test_syntax( "[\"\\x7F\"]" );
+            test_syntax( "[\"\\x80\"]", false );
+            test_syntax( "[\"\\x8\"]" );
+            test_syntax( "[\"\\xg\"]", false );
+            test_syntax( "[\"\\\"]", false );
         }
 
         Value_type read_cstr( const char* c_str )
@@ -319,11 +343,11 @@ namespace
 
             check_reading( "{\n"
                             "    \"name 1\" : \"value 1\",\n"
-                            "    \"name 2\" : 1.200000000000000,\n"
+                            "    \"name 2\" : 1.2,\n"
                             "    \"name 3\" : \"value 3\",\n"
-                            "    \"name_4\" : 1.234567890123456e+125,\n"
-                            "    \"name_5\" : -1.234000000000000e-123,\n"
-                            "    \"name_6\" : 1.000000000000000e-123,\n"
+                            "    \"name_4\" : 1.2345678e125,\n"
+                            "    \"name_5\" : -1.234e-123,\n"
+                            "    \"name_6\" : 1e-123,\n"
                             "    \"name_7\" : 1234567890.123456\n"
                             "}" );
 
@@ -335,7 +359,7 @@ namespace
 
             check_reading( "[\n"
                            "    1,\n"
-                           "    1.200000000000000,\n"
+                           "    1.2,\n"
                            "    \"john]\",\n"
                            "    true,\n"
                            "    false,\n"
@@ -460,6 +484,13 @@ namespace
             {
                 assert_eq( error, expected_error );
             }
+
+            basic_istringstream< Char_type > is_2( in_s );
+
+            Error_position error;
+
+            assert_eq( read( is_2, value, error ), expected_success );
+            assert_eq( error, expected_error );
         }
 
         void test_from_stream()
@@ -536,6 +567,45 @@ namespace
             {
                 assert_eq( posn, Error_position( line, column, reason ) );
             }
+
+            check_read_fails_without_throwing( c_str, Error_position( line, column, reason ) );
+        }
+
+        void check_read_fails_without_throwing( const char* c_str, const Error_position& expected_error )
+        {
+            const String_type s( to_str( c_str ) );
+
+            Value_type value;
+            Error_position error;
+
+            assert_eq( read( s, value, error ), false );
+            assert_eq( error, expected_error );
+
+            error = Error_position();
+
+            typename String_type::const_iterator begin = s.begin();
+
+            assert_eq( read( begin, s.end(), value, error ), false );
+            assert_eq( error, expected_error );
+            assert( begin == s.begin() );
+
+            try
+            {
+                read_or_throw( begin, s.end(), value );
+
+                assert( false );
+            }
+            catch( const Error_position posn )
+            {
+                assert_eq( posn, expected_error );
+            }
+
+            error = Error_position();
+
+            basic_istringstream< Char_type > is( s );
+
+            assert_eq( read( is, value, error ), false );
+            assert_eq( error, expected_error );
         }
 
         void test_error_cases()
@@ -560,6 +630,10 @@ namespace
             check_read_fails( "{\n  name\":\"value\"}", 2, 3,  "not an object" );
             check_read_fails( "{\"name\":foo}",         1, 9,  "not a value" );
             check_read_fails( "{\"name\":value\"}",     1, 9,  "not a value" );
+            check_read_fails( "{\"name\":1,}",           1, 10, "not an object" );
+            check_read_fails( "[1, ]",                  1, 3,  "not an array" );
+            check_read_fails( "\t[\t}",                  1, 9,  "not an array" );
+            check_read_fails( "[1,\r\n2,\r\n3,]",     3, 2,  "not an array" );
         }
 
         typedef vector< int > Ints;
@@ -728,6 +802,49 @@ namespace
             test_uint64( "18446744073709551615", -1, -1, ULLONG_MAX );
         }
 
+        void check_real( const char* value_str )
+        {
+            const Value_type v( read_cstr( value_str ) );
+
+            assert_eq( v.type(), real_type );
+            assert_eq( v.get_real(), strtod( value_str, 0 ) );  // correctly rounded, so the same as the C library
+        }
+
+        void test_numbers()
+        {
+            assert_eq( read_cstr( "9223372036854775807" ).get_int64(), LLONG_MAX );
+            assert_eq( read_cstr( "-9223372036854775808" ).get_int64(), LLONG_MIN );
+            assert_eq( read_cstr( "9223372036854775808" ).get_uint64(), 9223372036854775808ull );
+            assert_eq( read_cstr( "-0" ).get_int64(), 0 );
+
+            test_syntax( "18446744073709551616", false );
+            test_syntax( "-9223372036854775809", false );
+            test_syntax( "-18446744073709551615", false );
+            test_syntax( "[1e]", false );
+            test_syntax( "[1e+]", false );
+            test_syntax( "[-]", false );
+
+            check_real( "0.1" );
+            check_real( "1.5" );
+            check_real( "-0.0" );
+            check_real( "1e0" );
+            check_real( "1E+2" );
+            check_real( "1.234567890123456e125" );
+            check_real( "2.2250738585072011e-308" );
+            check_real( "4.9406564584124654e-324" );
+            check_real( "2.4703282292062328e-324" );
+            check_real( "1.7976931348623157e308" );
+            check_real( "9007199254740993.0" );
+            check_real( "1.00000000000000011102230246251565404236316680908203125" );
+            check_real( "1.00000000000000011102230246251565404236316680908203124" );
+            check_real( "1234567890123456789012345.678e-10" );
+            check_real( "0.000000000000000000000000000000000000000000000000001e51" );
+
+            assert_eq( read_cstr( "1e-400" ).get_real(), 0.0 );
+            assert_eq( read_cstr( "0e99999999999" ).get_real(), 0.0 );
+            assert_eq( read_cstr( "1e400" ).get_real(), numeric_limits< double >::infinity() );
+        }
+
         void test_types()
         {
             Value_type value;
@@ -749,6 +866,86 @@ namespace
             assert_eq( a[5].is_null(), true );
         }
 
+#if !defined( BOOST_NO_CXX11_RVALUE_REFERENCES ) && !defined( JSON_SPIRIT_USE_SPIRIT_GRAMMER )
+
+        // reading a document should allocate no more than building the same 
+        // values directly, moving each string into place once it is created
+        //
+        // the Spirit grammer shares the semantic actions that do the moving, but its rules 
+        // allocate as the grammer is constructed, so the count is only checked for the parser
+        //
+        void test_strings_are_not_copied()
+        {
+            const int nb_strs = 20;
+
+            vector< String_type > names;
+            vector< String_type > strs;
+
+            String_type json_str( to_str( "[ {" ) );
+
+            for( int i = 0; i < nb_strs; ++i )
+            {
+                // too long for the small string optimisation, so each string is one allocation
+
+                names.push_back( to_str( "name " ) + String_type( 50, 'a' + i ) );
+                strs .push_back( to_str( "value " ) + String_type( 50, 'a' + i ) );
+
+                json_str += ( i == 0 ? to_str( "\"" ) : to_str( ", \"" ) ) + names[i] + to_str( "\" : \"" ) + strs[i] + to_str( "\"" );
+            }
+
+            json_str += to_str( " }" );
+
+            for( int i = 0; i < nb_strs; ++i )
+            {
+                json_str += to_str( ", \"" ) + strs[i] + to_str( "\"" );
+            }
+
+            json_str += to_str( " ]" );
+
+            Value_type value;
+
+            unsigned long start = nb_allocations();
+
+            assert_eq( read( json_str, value ), true );
+
+            const unsigned long nb_read_allocations = nb_allocations() - start;
+
+            Value_type expected_value;
+
+            start = nb_allocations();
+
+            {
+                Object_type obj;
+
+                for( int i = 0; i < nb_strs; ++i )
+                {
+                    Config_type::add( obj, String_type( names[i] ), Value_type( String_type( strs[i] ) ) );
+                }
+
+                Array_type array;
+
+                array.emplace_back( std::move( obj ) );
+
+                for( int i = 0; i < nb_strs; ++i )
+                {
+                    array.emplace_back( String_type( strs[i] ) );
+                }
+
+                expected_value = Value_type( std::move( array ) );
+            }
+
+            const unsigned long nb_build_allocations = nb_allocations() - start;
+
+            assert_eq( value, expected_value );
+
+            // the reader's only extra allocation is for its stack of enclosing arrays and objects, 
+            // copying the strings would add one allocation for each of them
+
+            assert_eq( nb_read_allocations <= nb_build_allocations + 1, true );
+        }
+
+#endif
+
         void run_tests()
         {
             test_syntax();
@@ -759,7 +956,11 @@ namespace
             test_error_cases();
             test_sequence_of_values();
             test_uint64();
+            test_numbers();
             test_types();
+#if !defined( BOOST_NO_CXX11_RVALUE_REFERENCES ) && !defined( JSON_SPIRIT_USE_SPIRIT_GRAMMER )
+            test_strings_are_not_copied();
+#endif
         }
     };
 
@@ -791,22 +992,1657 @@ namespace
         test_extended_ascii( "\\u00E4\\u00F6\\u00FC\\u00DF" );
         test_extended_ascii( "" );
     }
-}
 
-//#include <fstream>
+    typedef internal_::Structural_index Structural_index;
 
-void json_spirit::test_reader()
-{
-    Test_runner< Config  >().run_tests();
-    Test_runner< mConfig >().run_tests();
+    // a character at a time version of the structural index to check the real one against
+    //
+    Structural_index::Offsets build_index_one_char_at_a_time( const string& s )
+    {
+        Structural_index::Offsets result;
+
+        bool in_string = false;
+
+        for( string::size_type i = 0; i < s.size(); ++i )
+        {
+            const char c = s[i];
+
+            if( c == '\\' )
+            {
+                if( in_string ) result.push_back( static_cast< Structural_index::Offset >( i ) );
+
+                ++i;  // skip the escaped character
+            }
+            else if( c == '"' )
+            {
+                result.push_back( static_cast< Structural_index::Offset >( i ) );
+
+                in_string = !in_string;
+            }
+            else if( !in_string && internal_::is_structural( c ) )
+            {
+                result.push_back( static_cast< Structural_index::Offset >( i ) );
+            }
+        }
+
+        return result;
+    }
+
+    void check_structural_index( const string& s )
+    {
+        const Structural_index::Offsets expected = build_index_one_char_at_a_time( s );
+
+        const Structural_index::Method methods[] = { Structural_index::best,
+                                                     Structural_index::scalar, 
+                                                     Structural_index::sse2, 
+                                                     Structural_index::avx2 };
+
+        for( int i = 0; i < 4; ++i )
+        {
+            Structural_index index;
+
+            if( index.build( s.data(), s.data() + s.size(), methods[i] ) )
+            {
+                assert_eq( index.offsets(), expected );
+            }
+            else
+            {
+                assert( methods[i] != Structural_index::best && methods[i] != Structural_index::scalar );
+            }
+        }
+    }
+
+    void test_structural_index()
+    {
+        check_structural_index( "" );
+        check_structural_index( "{\"a\":[1,2,{\"b\":\"c,d\"}]}" );
+        check_structural_index( "[\"\\\"\", \"\\\\\", \"\\\\\\\"\"]" );
+
+        // move escapes and strings across the boundaries of the 64 character blocks
+
+        for( string::size_type i = 0; i < 130; ++i )
+        {
+            check_structural_index( string( i, ' ' ) + "[\"ab\\\\\\\"c\", \"d\\\\\", {\"e\" : \"\\\"\"}]" );
+            check_structural_index( "[\"" + string( i, 'x' ) + "\\\"\\\\\", \"" + string( i, ',' ) + "\"]" );
+            check_structural_index( "[\"" + string( i, '\\' ) + "\", \"x\"]" );
+            check_structural_index( string( i, '"' ) + string( i, '[' ) );
+        }
+    }
+
+    template< class Value_type >
+    void check_read_str( const string& s, const string& expected )
+    {
+        Value_type value;
+
+        read_or_throw( s, value );
+
+        assert_eq( value.get_array()[0].get_str(), expected );
+        assert_eq( value.get_array()[1].get_int(), 1 );
+    }
+
+    // strings are searched for quotes and backslashes a block at a time, so move the escapes 
+    // across the boundaries of the 16 and 32 character blocks
+
+    void test_long_strings()
+    {
+        for( string::size_type i = 0; i < 70; ++i )
+        {
+            for( string::size_type j = 0; j < 40; j += 13 )
+            {
+                const string s( "[\"" + string( i, 'a' ) + "\\n" + string( j, 'b' ) + "\\\"\\\\\\u00e9\\x41" + string( i, 'c' ) + "\", 1]" );
+
+                const string expected( string( i, 'a' ) + "\n" + string( j, 'b' ) + "\"\\\xE9" "A" + string( i, 'c' ) );
+
+                check_read_str< Value  >( s, expected );
+                check_read_str< mValue >( s, expected );
+                check_read_str< vValue >( s, expected );
+
+                Value value;
+
+                istringstream is( s );
+
+                read_or_throw( is, value );
+
+                assert_eq( value.get_array()[0].get_str(), expected );
+            }
+
+            check_read_str< Value  >( "[\"" + string( i, 'x' ) + "\", 1]", string( i, 'x' ) );
+            check_read_str< vValue >( "[\"" + string( i, 'x' ) + "\", 1]", string( i, 'x' ) );
+
+            Value value;
+
+            assert_eq( read( "[\"" + string( i, 'x' ) + "\\", value ), false );
+            assert_eq( read( "[\"" + string( i, 'x' ), value ), false );
+        }
+    }
+
+    // a large document read from a stream arrives in many chunks, with strings and escape 
+    // sequences split between them, it should be read just the same as from a string
+
+    void check_large_document( const string& s, bool expected_success )
+    {
+        Value value_1;
+        Error_position error_1;
+
+        assert_eq( read( s, value_1, error_1 ), expected_success );
+
+        istringstream is( s );
+
+        Value value_2;
+        Error_position error_2;
+
+        assert_eq( read( is, value_2, error_2 ), expected_success );
+        assert_eq( error_1, error_2 );
+
+        if( expected_success ) assert_eq( value_1, value_2 );
+    }
+
+    // hands out its characters one at a time, like an unbuffered stream
+    //
+    class Unbuffered_streambuf : public streambuf
+    {
+    public:
+
+        explicit Unbuffered_streambuf( const string& s )
+        :   s_( s )
+        ,   i_( 0 )
+        {
+        }
+
+    protected:
+
+        virtual int_type underflow()
+        {
+            return i_ == s_.size() ? traits_type::eof() : traits_type::to_int_type( s_[i_] );
+        }
+
+        virtual int_type uflow()
+        {
+            return i_ == s_.size() ? traits_type::eof() : traits_type::to_int_type( s_[i_++] );
+        }
+
+    private:
+
+        const string s_;
+        string::size_type i_;
+    };
+
+    // records the events of read_events() as text
+
+    template< class String_type >
+    struct Event_recorder
+    {
+        void begin_obj()   { events_ += "{ "; }
+        void end_obj()     { events_ += "} "; }
+        void begin_array() { events_ += "[ "; }
+        void end_array()   { events_ += "] "; }
+
+        void new_name( const String_type& name ) { events_ += "name:" + narrow( name ) + " "; }
+        void new_str ( const String_type& s )    { events_ += "str:"  + narrow( s )    + " "; }
+
+        void new_bool( bool b )             { events_ += b ? "true " : "false "; }
+        void new_null()                     { events_ += "null "; }
+        void new_int( boost::int64_t i )    { events_ += "int:"    + lexical_cast< string >( i ) + " "; }
+        void new_uint64( boost::uint64_t i ) { events_ += "uint64:" + lexical_cast< string >( i ) + " "; }
+        void new_real( double d )           { events_ += "real:"   + lexical_cast< string >( d ) + " "; }
+
+        static string narrow( const String_type& s )
+        {
+            return string( s.begin(), s.end() );
+        }
+
+        string events_;
+    };
+
+    template< class String_type >
+    void check_events( const char* c_str, const char* expected_events )
+    {
+        const String_type s( c_str, c_str + strlen( c_str ) );
+
+        Event_recorder< String_type > recorder;
+
+        assert_eq( read_events( s, recorder ), true );
+        assert_eq( recorder.events_, string( expected_events ) );
+
+        Event_recorder< String_type > recorder_2;
+
+        typename String_type::const_iterator begin = s.begin();
+
+        read_events_or_throw( begin, s.end(), recorder_2 );
+        assert_eq( recorder_2.events_, string( expected_events ) );
+    }
+
+    void test_read_events()
+    {
+        check_events< string >( "{ \"a\" : [ 1, -2, 18446744073709551615, 2.5, \"x\\ty\" ], \"b\" : { \"c\" : null }, \"d\" : true, \"e\" : false }",
+                                "{ name:a [ int:1 int:-2 uint64:18446744073709551615 real:2.5 str:x\ty ] name:b { name:c null } name:d true name:e false } " );
+        check_events< string >( "\"abc\"", "str:abc " );
+        check_events< string >( "[]", "[ ] " );
 
 #ifndef BOOST_NO_STD_WSTRING
-    Test_runner< wConfig  >().run_tests();
-    Test_runner< wmConfig >().run_tests();
-    test_wide_esc_u();
+        check_events< wstring >( "{ \"a\" : [ 1, \"b\" ] }", "{ name:a [ int:1 str:b ] } " );
 #endif
 
-    test_extended_ascii();
+        // the events before an error have been seen, the error is reported as for read()
+
+        const string bad( "[ 1, 2 }" );
+
+        Event_recorder< string > recorder;
+        Error_position error;
+        Error_position expected_error;
+        Value value;
+
+        assert_eq( read_events( bad, recorder, error ), false );
+        assert_eq( read( bad, value, expected_error ), false );
+        assert_eq( error, expected_error );
+        assert_eq( recorder.events_, string( "[ int:1 int:2 " ) );
+
+        try
+        {
+            read_events_or_throw( bad, recorder );
+            assert( false );
+        }
+        catch( const Error_position& e )
+        {
+            assert_eq( e, expected_error );
+        }
+
+        // a sequence of values is read by advancing begin
+
+        const string seq( "1 [2] \"3\"" );
+
+        string::const_iterator begin = seq.begin();
+
+        Event_recorder< string > seq_recorder;
+
+        while( read_events( begin, seq.end(), seq_recorder ) ) {}
+
+        assert_eq( seq_recorder.events_, string( "int:1 [ int:2 ] str:3 " ) );
+    }
+
+    void check_cursor_error( const string& s, void ( *walk )( Cursor& ), const Error_position& expected_error )
+    {
+        try
+        {
+            Cursor c( s );
+
+            walk( c );
+
+            assert( false );
+        }
+        catch( const Error_position& e )
+        {
+            assert_eq( e, expected_error );
+        }
+    }
+
+    void walk_all( Cursor& c )
+    {
+        c.enter_object();
+
+        string key;
+
+        while( c.next_key( key ) ) c.skip();
+    }
+
+    void read_int_as_str( Cursor& c )
+    {
+        c.enter_array();
+        c.next_element();
+        c.get_str();
+    }
+
+    void read_real_as_int( Cursor& c )
+    {
+        c.enter_array();
+        c.next_element();
+        c.get_int();
+    }
+
+    void read_bad_value( Cursor& c )
+    {
+        Value value;
+
+        c.enter_array();
+        c.next_element();
+        c.get_value( value );
+    }
+
+    void test_cursor()
+    {
+        const string s( "{ \"id\" : 42, \"skipped\" : { \"a\" : [ 1, \"]}\\\"\", { } ] }, \"name\" : \"n\\u00e9\",\n"
+                        "  \"values\" : [ 1.5, -2, 18446744073709551615, true, null, [ 3 ] ], \"sub\" : { \"x\" : [ 1, { \"y\" : false } ] } }" );
+
+        Cursor c( s );
+
+        assert_eq( c.type(), obj_type );
+
+        c.enter_object();
+
+        string key;
+
+        assert_eq( c.next_key( key ), true );  assert_eq( key, "id" );
+        assert_eq( c.type(), int_type );
+        assert_eq( c.get_int(), 42 );
+
+        assert_eq( c.next_key( key ), true );  assert_eq( key, "skipped" );
+        c.skip();
+
+        assert_eq( c.next_key( key ), true );  assert_eq( key, "name" );
+        assert_eq( c.get_str(), "n\xe9" );
+
+        assert_eq( c.next_key( key ), true );  assert_eq( key, "values" );
+        c.enter_array();
+        assert_eq( c.next_element(), true );  assert_eq( c.type(), real_type );  assert_eq( c.get_real(), 1.5 );
+        assert_eq( c.next_element(), true );  assert_eq( c.get_int64(), -2 );
+        assert_eq( c.next_element(), true );  assert_eq( c.get_uint64(), ULLONG_MAX );
+        assert_eq( c.next_element(), true );  assert_eq( c.get_bool(), true );
+        assert_eq( c.next_element(), true );  assert_eq( c.type(), null_type );  c.get_null();
+        assert_eq( c.next_element(), true );  c.skip();
+        assert_eq( c.next_element(), false );
+
+        assert_eq( c.next_key( key ), true );  assert_eq( key, "sub" );
+
+        Value sub;
+
+        c.get_value( sub );
+
+        assert_eq( write( sub ), "{\"x\":[1,{\"y\":false}]}" );
+
+        assert_eq( c.next_key( key ), false );
+        assert( c.posn() == s.end() );
+
+        Cursor c_2( s );
+
+        walk_all( c_2 );
+
+        check_cursor_error( "{ \"a\" : 1 \"b\" : 2 }", walk_all,  Error_position( 1, 11, "not an object" ) );
+        check_cursor_error( "{ \"a\" 1 }",          walk_all,        Error_position( 1, 7, "no colon in pair" ) );
+        check_cursor_error( "{ \"a\" : [ 1, 2 ",    walk_all,        Error_position( 1, 9, "not an array" ) );
+        check_cursor_error( "[ 1 ]",                 read_int_as_str,  Error_position( 1, 3, "not a string" ) );
+        check_cursor_error( "[ 1.5 ]",               read_real_as_int, Error_position( 1, 3, "not an integer" ) );
+        check_cursor_error( "[\n  [ 1, }",           read_bad_value,   Error_position( 2, 6, "not an array" ) );
+
+#ifndef BOOST_NO_STD_WSTRING
+        const wstring ws( L"[ \"abc\", 2 ]" );
+
+        wCursor wc( ws );
+
+        wc.enter_array();
+        assert_eq( wc.next_element(), true );  assert_eq( wc.get_str(), L"abc" );
+        assert_eq( wc.next_element(), true );  assert_eq( wc.get_int(), 2 );
+        assert_eq( wc.next_element(), false );
+#endif
+    }
+
+    template< class Value_type >
+    void check_read_file( const char* path, const string& s, bool expected_success )
+    {
+        Value_type expected_value;
+        Error_position expected_error;
+
+        assert_eq( read( s, expected_value, expected_error ), expected_success );
+
+        Value_type value;
+        Error_position error;
+
+        assert_eq( read_file( path, value ), expected_success );
+        assert_eq( read_file( path, value, error ), expected_success );
+        assert_eq( error, expected_error );
+
+        if( expected_success ) assert_eq( value, expected_value );
+
+        try
+        {
+            read_file_or_throw( path, value );
+
+            assert( expected_success );
+        }
+        catch( const Error_position& e )
+        {
+            assert_eq( e, expected_error );
+        }
+    }
+
+    void check_read_file( const string& s, bool expected_success )
+    {
+        const char* path = "json_spirit_reader_test.json";
+
+        {
+            ofstream os( path, ios::binary );
+
+            os << s;
+        }
+
+        check_read_file< Value  >( path, s, expected_success );
+        check_read_file< mValue >( path, s, expected_success );
+        check_read_file< cValue >( path, s, expected_success );
+
+        remove( path );
+    }
+
+    void test_read_file()
+    {
+        string s( "[" );
+
+        while( s.size() < 200000 )  // large enough to be mapped
+        {
+            s += "{\"name\" : \"va\\\"lue\", \"x\" : [ 1, 2.5, true ] },\n";
+        }
+
+        check_read_file( "", false );
+        check_read_file( "{ \"small\" : [ 1, 2 ] }", true );
+        check_read_file( s + "null]", true );
+        check_read_file( s + "nul]", false );
+
+        Value value;
+        Error_position error;
+
+        assert_eq( read_file( "no such directory/no such file.json", value, error ), false );
+        assert_eq( error, Error_position( 0, 0, "cannot read file" ) );
+    }
+
+    // writes each value to the slot for its line, so it can be called on several threads at once
+
+    template< class Value_type >
+    struct Line_recorder
+    {
+        Line_recorder( vector< string >& lines, size_t* last_line )
+        :   lines_( &lines )
+        ,   last_line_( last_line )
+        {
+        }
+
+        void operator()( size_t line, Value_type& value )
+        {
+            assert( line < lines_->size() );
+            assert( ( *lines_ )[ line ].empty() );
+
+            ( *lines_ )[ line ] = write( value );
+
+            if( last_line_ != 0 )  // expecting lines in order
+            {
+                assert( line > *last_line_ );
+
+                *last_line_ = line;
+            }
+        }
+
+        vector< string >* lines_;
+        size_t* last_line_;
+    };
+
+    template< class Value_type >
+    void throw_on_line_777( size_t line, Value_type& )
+    {
+        if( line == 777 ) throw runtime_error( "line 777" );
+    }
+
+    template< class Value_type >
+    void check_read_lines( const string& s, const vector< string >& expected_lines, 
+                           const Error_position* expected_error, unsigned int nb_threads, Line_order order )
+    {
+        vector< string > lines( expected_lines.size() );
+        size_t last_line = 0;
+        Error_position error;
+
+        const bool success = read_lines< Value_type >( s, Line_recorder< Value_type >( lines, order == lines_in_order ? &last_line : 0 ), 
+                                                       error, nb_threads, order );
+
+        assert_eq( success, expected_error == 0 );
+        assert( lines == expected_lines );
+
+        if( expected_error != 0 ) assert_eq( error, *expected_error );
+
+        vector< string > other_lines( expected_lines.size() );
+
+        try
+        {
+            read_lines_or_throw< Value_type >( s, Line_recorder< Value_type >( other_lines, 0 ), nb_threads, order );
+
+            assert( expected_error == 0 );
+        }
+        catch( const Error_position& e )
+        {
+            assert_eq( e, *expected_error );
+        }
+
+        assert( other_lines == expected_lines );
+    }
+
+    template< class Value_type >
+    void check_read_lines( const string& s, const vector< string >& expected_lines, const Error_position* expected_error )
+    {
+        const unsigned int nb_threads[] = { 1, 2, 3, 0 };
+
+        for( unsigned int i = 0; i < sizeof( nb_threads ) / sizeof( nb_threads[0] ); ++i )
+        {
+            check_read_lines< Value_type >( s, expected_lines, expected_error, nb_threads[i], lines_in_order );
+            check_read_lines< Value_type >( s, expected_lines, expected_error, nb_threads[i], lines_in_any_order );
+        }
+    }
+
+    void check_callback_exception( const string& s, unsigned int nb_threads, Line_order order )
+    {
+        try
+        {
+            read_lines< Value >( s, &throw_on_line_777< Value >, nb_threads, order );
+
+            assert( false );
+        }
+        catch( const runtime_error& e )
+        {
+            assert_eq( string( e.what() ), "line 777" );
+        }
+    }
+
+    void test_read_lines()
+    {
+        const size_t nb_lines = 20000;  // enough for several chunks
+
+        vector< string > lines( 1 );  // there is no line 0
+
+        for( size_t i = 1; i <= nb_lines; ++i )
+        {
+            const string n = lexical_cast< string >( i );
+
+            if     ( i % 100 == 0 ) lines.push_back( " \t " );
+            else if( i % 7   == 0 ) lines.push_back( "{ \"i\" : " + n + ", \"s\" : \"a\\tb\" }\r" );
+            else                    lines.push_back( "[" + n + ", true, null]" );
+        }
+
+        vector< string > expected_lines( lines.size() );
+
+        for( size_t i = 1; i < lines.size(); ++i )
+        {
+            Value value;
+
+            if( i % 100 != 0 )
+            {
+                read_or_throw( lines[i], value );
+
+                expected_lines[i] = write( value );
+            }
+        }
+
+        string s;
+
+        for( size_t i = 1; i < lines.size(); ++i )
+        {
+            s += lines[i] + '\n';
+        }
+
+        check_read_lines< Value  >( s, expected_lines, 0 );
+        check_read_lines< mValue >( s, expected_lines, 0 );
+
+        check_callback_exception( s, 1, lines_in_order );
+        check_callback_exception( s, 3, lines_in_order );
+        check_callback_exception( s, 3, lines_in_any_order );
+
+        lines[ 5000 ]  = "{";
+        lines[ 15000 ] = "[1] x";
+
+        expected_lines[ 5000 ]  = "";
+        expected_lines[ 15000 ] = "";
+
+        s.clear();
+
+        for( size_t i = 1; i < lines.size(); ++i )
+        {
+            s += lines[i];
+
+            if( i != nb_lines ) s += '\n';  // the last line need not end with a newline
+        }
+
+        Value value;
+        Error_position expected_error;
+
+        read( lines[ 5000 ], value, expected_error );
+
+        expected_error.line_ = 5000;
+
+        check_read_lines< Value  >( s, expected_lines, &expected_error );
+        check_read_lines< mValue >( s, expected_lines, &expected_error );
+
+        const Error_position extra_text_error( 3, 5, "extra text after the value" );
+
+        check_read_lines< Value >( "1\n\n[1] x\n2", list_of( "" )( "1" )( "" )( "" )( "2" ), &extra_text_error );
+        check_read_lines< Value >( "", vector< string >( 1 ), 0 );
+    }
+
+    template< class Value_type >
+    void check_read_in_parallel( const string& s, unsigned int nb_threads )
+    {
+        Value_type expected_value;
+        Error_position expected_error;
+
+        const bool expected_success = read( s, expected_value, expected_error );
+
+        Value_type value;
+        Error_position error;
+
+        assert_eq( read_in_parallel( s, value, error, nb_threads ), expected_success );
+
+        if( expected_success )
+        {
+            assert_eq( value, expected_value );
+        }
+        else
+        {
+            assert_eq( error, expected_error );
+        }
+
+        try
+        {
+            read_in_parallel_or_throw( s, value, nb_threads );
+
+            assert( expected_success );
+        }
+        catch( const Error_position& e )
+        {
+            assert_eq( e, expected_error );
+        }
+    }
+
+    template< class Value_type >
+    void check_read_in_parallel( const string& s )
+    {
+        check_read_in_parallel< Value_type >( s, 1 );
+        check_read_in_parallel< Value_type >( s, 3 );
+        check_read_in_parallel< Value_type >( s, 0 );
+    }
+
+    void check_read_file_in_parallel( const string& s )
+    {
+        const char* path = "json_spirit_reader_test.json";
+
+        {
+            ofstream os( path, ios::binary );
+
+            os << s;
+        }
+
+        Value expected_value;
+        Error_position expected_error;
+
+        const bool expected_success = read( s, expected_value, expected_error );
+
+        Value value;
+        Error_position error;
+
+        assert_eq( read_file_in_parallel( path, value, error, 3 ), expected_success );
+
+        if( expected_success )
+        {
+            assert_eq( value, expected_value );
+        }
+        else
+        {
+            assert_eq( error, expected_error );
+        }
+
+        remove( path );
+    }
+
+    void test_read_in_parallel()
+    {
+        string records;
+
+        for( int i = 0; records.size() < 1100000; ++i )  // large enough to be split into many parts
+        {
+            records += "{ \"id\" : " + lexical_cast< string >( i ) + 
+                       ", \"name\" : \"a, [b] {c} \\\" \\\\\", \"tags\" : [ \"x\", [ 1, 2.5 ], {} ], \"ok\" : true },\n";
+        }
+
+        check_read_in_parallel< Value  >( "[" + records + "1 ]" );
+        check_read_in_parallel< mValue >( "[" + records + "1 ]" );
+        check_read_in_parallel< Value  >( "\r\n [" + records + "1 ] trailing text is not read" );
+        check_read_in_parallel< Value  >( "[" + records + "\"" + string( 600000, 'a' ) + "\", " + records + "1 ]" );
+        check_read_in_parallel< Value  >( "[" + records + "\"" + string( 1100000, 'a' ) + "\" ]" );
+        check_read_in_parallel< Value  >( "{ \"a\" : [" + records + "1 ] }" );
+
+        // errors are reported as read() reports them
+
+        check_read_in_parallel< Value  >( "[" + records + "nul ]" );
+        check_read_in_parallel< mValue >( "[" + records + "nul ]" );
+        check_read_in_parallel< Value  >( "[ { \"id\" : x }, " + records + "1 ]" );
+        check_read_in_parallel< Value  >( "[" + records + "]" );
+        check_read_in_parallel< Value  >( "[" + records + "1 }" );
+        check_read_in_parallel< Value  >( "[" + records + "1" );
+        check_read_in_parallel< Value  >( "[" + records + records.substr( 0, records.size() / 2 ) );
+        check_read_in_parallel< Value  >( "[ 1, 2 " );
+        check_read_in_parallel< Value  >( "" );
+
+        check_read_file_in_parallel( "[" + records + "1 ]" );
+        check_read_file_in_parallel( "[" + records + "nul ]" );
+
+        Value value;
+        Error_position error;
+
+        assert_eq( read_file_in_parallel( "no such directory/no such file.json", value, error ), false );
+        assert_eq( error, Error_position( 0, 0, "cannot read file" ) );
+    }
+
+    void test_stream_is_left_after_value()
+    {
+        istringstream is( "[1] {\"a\":2}\"xyz\"3 true tail" );
+
+        Value value;
+
+        read_or_throw( is, value );  assert_eq( value, Value( Array( 1, 1 ) ) );
+        read_or_throw( is, value );  assert_eq( value.get_obj().size(), 1u );
+        read_or_throw( is, value );  assert_eq( value, Value( "xyz" ) );
+        read_or_throw( is, value );  assert_eq( value, Value( 3 ) );
+        read_or_throw( is, value );  assert_eq( value, Value( true ) );
+
+        assert( !is.eof() );
+
+        string rest;
+
+        getline( is, rest );
+
+        assert_eq( rest, " tail" );
+
+        string s( "[" );
+
+        while( s.size() < 10000 ) s += "\"abc\", 1.5, ";
+
+        s += "0]";
+
+        Value expected_value;
+        
+        read_or_throw( s, expected_value );
+
+        Unbuffered_streambuf buf( s + " [] " );
+        istream unbuffered_is( &buf );
+
+        read_or_throw( unbuffered_is, value );
+        assert_eq( value, expected_value );
+
+        read_or_throw( unbuffered_is, value );
+        assert_eq( value, Value( Array() ) );
+    }
+
+    template< class Value_type >
+    void check_reading_into_arena( const string& s, const Value& expected_value )
+    {
+        Arena arena;
+
+        {
+            Arena::Scope scope( arena );
+
+            Value_type value;
+
+            const unsigned long start = nb_allocations();
+
+            assert_eq( read( s, value ), true );
+
+            // only the arena's block, its list of blocks and the reader's stack come from the heap,
+            // every string, object and array is in the arena, the Spirit grammer allocates its rules
+
+#ifndef JSON_SPIRIT_USE_SPIRIT_GRAMMER
+            assert_eq( nb_allocations() - start <= 3, true );
+#endif
+            assert( arena.bytes_allocated() > s.size() );
+
+            assert_eq( write( value ), write( expected_value ) );
+        }
+
+        assert( Arena::current() == 0 );
+
+        arena.release();
+
+        assert_eq( arena.bytes_allocated(), 0u );
+    }
+
+    void test_arena()
+    {
+        string s( "[ { " );
+
+        for( int i = 0; i < 20; ++i )
+        {
+            const string long_str( 40, 'a' + i );
+
+            s += ( i == 0 ? "\"" : ", \"" ) + long_str + "\" : \"" + long_str + "\"";
+        }
+
+        s += " }, [ 1, 2.5, true, null, \"\\u0041\" ] ]";
+
+        Value value;
+
+        assert_eq( read( s, value ), true );
+
+        check_reading_into_arena< aValue  >( s, value );
+        check_reading_into_arena< amValue >( s, value );
+
+        // without a current arena the "a" configs allocate from the heap
+
+        aValue value_2;
+
+        assert_eq( read( s, value_2 ), true );
+        assert_eq( write( value_2 ), write( value ) );
+
+        // swapping arrays of different arenas swaps their allocators too
+
+        Arena arena_1;
+        Arena arena_2;
+
+        aValue value_1;
+
+        {
+            Arena::Scope scope( arena_1 );
+
+            assert_eq( read( s, value_1 ), true );
+        }
+
+        {
+            Arena::Scope scope( arena_2 );
+
+            assert_eq( read( "[ \"x\" ]", value_2 ), true );
+        }
+
+        value_1.get_array().swap( value_2.get_array() );
+
+        assert( value_1.get_array().get_allocator().arena() == &arena_2 );
+        assert( value_2.get_array().get_allocator().arena() == &arena_1 );
+        assert_eq( write( value_2 ), write( value ) );
+        assert_eq( write( value_1 ), "[\"x\"]" );
+
+        value_1 = aValue();
+        value_2 = aValue();
+    }
+
+#if !defined( BOOST_NO_CXX11_RVALUE_REFERENCES ) && !defined( BOOST_NO_CXX11_DELETED_FUNCTIONS ) && !defined( BOOST_NO_CXX11_DECLTYPE )
+
+    // whether a Value_type can be read from a temporary string
+
+    template< class Value_type >
+    struct Reads_temporary
+    {
+        template< class T >
+        static std::true_type test( decltype( read( string(), std::declval< T& >() ) )* );
+
+        template< class T >
+        static std::false_type test( ... );
+
+        static const bool value = decltype( test< Value_type >( 0 ) )::value;
+    };
+
+#endif
+
+    bool refers_to( const String_view< char >& view, const string& s )
+    {
+        return !view.owns_text() && view.data() >= s.data() && view.data() + view.size() <= s.data() + s.size();
+    }
+
+    void test_string_views()
+    {
+        const string s( "{ \"name\" : \"value\", \"esc\\taped\" : \"a\\u0042c\", \"arr\" : [ \"\", 1, \"x\" ] }" );
+
+        Value value;
+
+        assert_eq( read( s, value ), true );
+
+        vValue view_value;
+
+        assert_eq( read( s, view_value ), true );
+        assert_eq( write( view_value ), write( value ) );
+
+        const vObject& obj = view_value.get_obj();
+
+        assert_eq( obj.size(), 3u );
+        assert_eq( refers_to( obj[0].name_, s ), true );
+        assert_eq( refers_to( obj[0].value_.get_str(), s ), true );
+        assert_eq( obj[0].value_.get_str(), string( "value" ) );
+
+        assert( obj[1].name_.owns_text() );
+        assert( obj[1].value_.get_str().owns_text() );
+        assert_eq( obj[1].name_, string( "esc\taped" ) );
+        assert_eq( obj[1].value_.get_str(), string( "aBc" ) );
+
+        const vArray& arr = obj[2].value_.get_array();
+
+        assert_eq( arr[0].get_str().size(), 0u );
+        assert_eq( refers_to( arr[2].get_str(), s ), true );
+
+        // a copy of the value still refers to the same text
+
+        const vValue view_value_2( view_value );
+
+        assert_eq( view_value_2.get_obj()[0].name_.data(), obj[0].name_.data() );
+
+        vValue bad_value;
+
+        const string bad_s( "[ \"abc\" " );
+
+        assert_eq( read( bad_s, bad_value ), false );
+
+        // no string is allocated, only the object's array of pairs and its recursive_wrapper
+
+        string long_s( "{ " );
+
+        for( int i = 0; i < 20; ++i )
+        {
+            const string long_str( 40, 'a' + i );
+
+            long_s += ( i == 0 ? "\"" : ", \"" ) + long_str + "\" : \"" + long_str + "\"";
+        }
+
+        long_s += " }";
+
+        const unsigned long start = nb_allocations();
+
+        vValue long_value;
+
+        assert_eq( read( long_s, long_value ), true );
+#ifndef JSON_SPIRIT_USE_SPIRIT_GRAMMER  // the grammer allocates its rules
+        assert_eq( nb_allocations() - start < 10, true );
+#endif
+        assert_eq( refers_to( long_value.get_obj()[19].value_.get_str(), long_s ), true );
+
+#ifndef BOOST_NO_STD_WSTRING
+        const wstring ws( L"[ \"abc\", \"d\\u00e9f\" ]" );
+
+        wvValue wview_value;
+
+        assert_eq( read( ws, wview_value ), true );
+        assert( !wview_value.get_array()[0].get_str().owns_text() );
+        assert( wview_value.get_array()[0].get_str() == wstring( L"abc" ) );
+        assert( wview_value.get_array()[1].get_str() == wstring( L"d\u00e9f" ) );
+        assert( write( wview_value ) == L"[\"abc\",\"d\\u00E9f\"]" );
+#endif
+
+#if !defined( BOOST_NO_CXX11_RVALUE_REFERENCES ) && !defined( BOOST_NO_CXX11_DELETED_FUNCTIONS ) && !defined( BOOST_NO_CXX11_DECLTYPE )
+        // views cannot be read from temporary text
+
+        assert( !Reads_temporary< vValue >::value );
+        assert(  Reads_temporary< Value  >::value );
+        assert( ( !std::is_constructible< Cursor, string&& >::value ) );
+        assert( (  std::is_constructible< Cursor, const string& >::value ) );
+#endif
+    }
+
+    void test_interned_names()
+    {
+        string s( "[" );
+
+        for( int i = 0; i < 100; ++i )
+        {
+            if( i != 0 ) s += ", ";
+
+            s += "{ \"id\" : " + lexical_cast< string >( i ) + ", \"na\\u006De\" : \"value " + lexical_cast< string >( i ) + "\", \"tags\" : [ \"a\", \"id\" ] }";
+        }
+
+        s += "]";
+
+        Value value;
+
+        assert_eq( read( s, value ), true );
+
+        iValue interned_value;
+
+        assert_eq( read( s, interned_value ), true );
+        assert_eq( write( interned_value ), write( value ) );
+
+        const iArray& records = interned_value.get_array();
+
+        assert_eq( records.size(), 100u );
+
+        const iObject& first = records[0].get_obj();
+
+        assert_eq( first[1].name_, string( "name" ) );
+        assert( first[1].name_ == "name" );
+
+        for( iArray::size_type i = 1; i < records.size(); ++i )
+        {
+            const iObject& record = records[i].get_obj();
+
+            for( iObject::size_type j = 0; j < record.size(); ++j )
+            {
+                assert( record[j].name_.shares_text( first[j].name_ ) );
+            }
+
+            assert_eq( find_value( record, first[0].name_ ).get_int(), int( i ) );
+            assert_eq( find_value( record, string( "name" ) ).get_str(), "value " + lexical_cast< string >( i ) );
+
+            const Object_index< iObject > index( record );
+
+            assert_eq( find_value( index, "name" ).get_str(), "value " + lexical_cast< string >( i ) );
+            assert_eq( find_value( index, first[0].name_ ).get_int(), int( i ) );
+        }
+
+        // the strings of values are not interned
+
+        const iArray& tags = first[2].value_.get_array();
+
+        assert_eq( tags[1].get_str(), first[0].name_ );
+        assert( !tags[1].get_str().shares_text( first[0].name_ ) );
+
+        // a Reader keeps its names, so the values it reads share them
+
+        Reader< iValue > reader;
+
+        iValue value_1;
+        iValue value_2;
+
+        reader.parse_or_throw( "{ \"abc\" : 1 }", value_1 );
+        reader.parse_or_throw( "{ \"abc\" : 2, \"\" : 3 }", value_2 );
+
+        assert( value_1.get_obj()[0].name_.shares_text( value_2.get_obj()[0].name_ ) );
+        assert( value_2.get_obj()[1].name_.empty() );
+
+        // a value built by hand is written like any other
+
+        iObject obj;
+
+        obj.push_back( iPair( "x", iValue( "y" ) ) );
+        obj.push_back( iPair( string( "n" ), 1 ) );
+
+        assert_eq( write( obj ), string( "{\"x\":\"y\",\"n\":1}" ) );
+
+        Value plain_value;
+
+        assert_eq( read( write( obj ), plain_value ), true );
+        assert_eq( write_formatted( iValue( obj ) ), write_formatted( plain_value ) );
+
+        iValue bad_value;
+
+        assert_eq( read( string( "{ \"abc\" 1 }" ), bad_value ), false );
+
+        std::istringstream is( s );
+
+        iValue stream_value;
+
+        assert_eq( read( is, stream_value ), true );
+        assert( stream_value == interned_value );
+
+#ifndef BOOST_NO_STD_WSTRING
+        const wstring ws( L"[ { \"d\\u00e9f\" : \"x\" }, { \"d\u00e9f\" : \"y\" } ]" );
+
+        wiValue wvalue;
+
+        assert_eq( read( ws, wvalue ), true );
+        assert( wvalue.get_array()[0].get_obj()[0].name_ == wstring( L"d\u00e9f" ) );
+        assert( wvalue.get_array()[1].get_obj()[0].name_.shares_text( wvalue.get_array()[0].get_obj()[0].name_ ) );
+        assert( write( wvalue ) == L"[{\"d\\u00E9f\":\"x\"},{\"d\\u00E9f\":\"y\"}]" );
+#endif
+    }
+
+    void test_hash_objects()
+    {
+        hValue value;
+
+        assert_eq( read( string( "{ \"b\" : 1, \"a\" : [ { \"c\" : null } ], \"b\" : 3 }" ), value ), true );
+
+        const hObject& obj = value.get_obj();
+
+        assert_eq( obj.size(), 2u );
+        assert_eq( obj.find( "b" )->second.get_int(), 3 );  // the last value wins, in the place of the first
+        assert_eq( write( value ), string( "{\"b\":3,\"a\":[{\"c\":null}]}" ) );
+
+        mValue map_value;
+
+        assert_eq( read( write( value ), map_value ), true );
+        assert_eq( write( map_value ), string( "{\"a\":[{\"c\":null}],\"b\":3}" ) );
+    }
+
+    void test_flat_objects()
+    {
+        fValue value;
+
+        assert_eq( read( string( "{ \"b\" : 1, \"a\" : [ { \"d\" : null, \"c\" : {} } ], \"b\" : 3 }" ), value ), true );
+
+        const fObject& obj = value.get_obj();
+
+        assert_eq( obj.is_sorted(), true );
+        assert_eq( obj.size(), 2u );
+        assert_eq( obj.find( "b" )->second.get_int(), 3 );  // the last value wins, as for an mValue
+        assert_eq( obj.find( "a" )->second.get_array()[0].get_obj().is_sorted(), true );
+
+        mValue map_value;
+
+        assert_eq( read( write( value ), map_value ), true );
+        assert_eq( write( value ), write( map_value ) );
+
+        // enough members, out of order, to be sorted with a buffer
+
+        string s( "{ \"0\" : -1" );
+
+        for( int i = 99; i >= 0; --i )
+        {
+            s += ", \"" + lexical_cast< string >( i ) + "\" : " + lexical_cast< string >( i );
+        }
+
+        s += " }";
+
+        assert_eq( read( s, value ), true );
+        assert_eq( read( s, map_value ), true );
+        assert_eq( value.get_obj().size(), 100u );
+        assert_eq( value.get_obj().find( "0" )->second.get_int(), 0 );
+        assert_eq( write( value ), write( map_value ) );
+    }
+
+    template< class Value_type >
+    void check_writing_copies_nothing( const string& s )
+    {
+        Value_type value;
+
+        assert_eq( read( s, value ), true );
+
+        const unsigned long start = nb_allocations();
+
+        const string written = write( value );
+
+        assert_eq( nb_allocations() - start < 50, true );  // the output buffer growing, copying each member would be thousands
+        assert_eq( written.size(), write( value ).size() );
+    }
+
+    void test_writing_copies_nothing()
+    {
+        string s;
+
+        for( int i = 0; i < 100; ++i )
+        {
+            s += "{ \"name " + lexical_cast< string >( i ) + " with enough text to be allocated\" : [ \"text long enough to be allocated\", ";
+        }
+
+        s += "null";
+
+        for( int i = 0; i < 100; ++i ) s += " ] }";
+
+        check_writing_copies_nothing< Value  >( s );
+        check_writing_copies_nothing< mValue >( s );
+        check_writing_copies_nothing< cValue >( s );
+        check_writing_copies_nothing< hValue >( s );
+        check_writing_copies_nothing< fValue >( s );
+    }
+
+    void test_large_document()
+    {
+        string s( "[" );
+
+        while( s.size() < 100000 )
+        {
+            s += "{\"name\\t\" : \"va\\\"lue\\\\\", \"x\" : [ 1, 2.5, \"\\x41\\u0042\", true ] },\n";
+        }
+
+        check_large_document( s + "null]", true );
+        check_large_document( s + "\"\\x80\"]", false );
+        check_large_document( s + "\"abc", false );
+        check_large_document( s + "\"abc\\", false );
+    }
+
+    template< class Value_type >
+    void check_reader( Reader< Value_type >& reader, const typename Reader< Value_type >::Text_type& s )
+    {
+        Value_type expected_value;
+        Error_position expected_error;
+
+        const bool expected_success = read( s, expected_value, expected_error );
+
+        Value_type value;
+        Error_position error;
+
+        assert_eq( reader.parse( s, value, error ), expected_success );
+
+        if( expected_success )
+        {
+            assert_eq( value, expected_value );
+        }
+        else
+        {
+            assert_eq( error, expected_error );
+        }
+
+        try
+        {
+            reader.parse_or_throw( s, value );
+
+            assert( expected_success );
+        }
+        catch( const Error_position& e )
+        {
+            assert_eq( e, expected_error );
+        }
+    }
+
+    template< class Value_type >
+    void check_reader( const vector< string >& docs )
+    {
+        Reader< Value_type > reader;
+
+        for( int i = 0; i < 2; ++i )  // the second time round reuses what the first left behind
+        {
+            for( vector< string >::const_iterator j = docs.begin(); j != docs.end(); ++j )
+            {
+                check_reader( reader, *j );
+            }
+        }
+    }
+
+    void test_reader_class()
+    {
+        string large_doc( "[" );
+
+        while( large_doc.size() < 100000 )  // large enough for the reader's stacks to grow
+        {
+            large_doc += "{\"name\\t\" : \"va\\\"lue\\\\\", \"x\" : [ 1, 2.5, true ] },\n";
+        }
+
+        vector< string > docs;
+
+        docs.push_back( "[ 1, 2 ]" );
+        docs.push_back( "{ \"a\" : [ { \"b\" : [ 1, \"x\\ty\" ] } ], \"c\" : null }" );
+        docs.push_back( "{ \"a\" : [ 1, }" );
+        docs.push_back( "  true  " );
+        docs.push_back( "[ [ [ [ [ [ [ [ \"deep\" ] ] ] ] ] ] ] ]" );
+        docs.push_back( "[ 1, 2 " );
+        docs.push_back( "" );
+        docs.push_back( large_doc + "null]" );
+        docs.push_back( large_doc + "nul]" );
+
+        check_reader< Value  >( docs );
+        check_reader< mValue >( docs );
+        check_reader< cValue >( docs );
+        check_reader< vValue >( docs );
+
+#ifndef BOOST_NO_STD_WSTRING
+        Reader< wValue > wide_reader;
+
+        check_reader( wide_reader, L"{ \"a\" : [ 1, \"\\u00e9\" ] }" );
+        check_reader( wide_reader, L"[ 1, " );
+        check_reader( wide_reader, L"[ \"wide\" ]" );
+#endif
+
+        // values are read one after another from a range
+
+        Reader< Value > reader;
+
+        const string values( "[ 1 ] { \"a\" : 2 } x" );
+
+        const char* begin = values.data();
+        const char* const end = values.data() + values.size();
+
+        Value value;
+        Error_position error;
+
+        assert_eq( reader.parse( begin, end, value, error ), true );
+        assert_eq( write( value ), "[1]" );
+        assert_eq( reader.parse( begin, end, value, error ), true );
+        assert_eq( write( value ), "{\"a\":2}" );
+        assert_eq( reader.parse( begin, end, value, error ), false );
+        assert_eq( error, Error_position( 1, 2, "not a value" ) );  // from where the read began
+
+        // once the reader's stack has grown, reading a nested value only allocates the value
+
+        const string nested( string( 32, '[' ) + "1" + string( 32, ']' ) );
+
+        Value nested_value;
+
+        reader.parse_or_throw( nested, nested_value );
+
+        unsigned long start = nb_allocations();
+
+        read_or_throw( nested, nested_value );
+
+        const unsigned long nb_read_allocations = nb_allocations() - start;
+
+        start = nb_allocations();
+
+        reader.parse_or_throw( nested, nested_value );
+
+        assert_eq( nb_allocations() - start < nb_read_allocations, true );
+    }
+
+    // reads s with an Incremental_reader, feeding it in chunks of the given sizes, used in turn
+
+    template< class Value_type >
+    bool read_incrementally( const typename Incremental_reader< Value_type >::Text_type& s, const vector< int >& chunk_sizes,
+                             Value_type& value, Error_position& error )
+    {
+        typedef typename Incremental_reader< Value_type >::Char_type Char_type;
+
+        Incremental_reader< Value_type > reader( value );
+
+        const Char_type* begin = s.data();
+        const Char_type* const end = s.data() + s.size();
+
+        try
+        {
+            for( vector< int >::size_type i = 0; begin != end; ++i )
+            {
+                const Char_type* const chunk_end = ( std::min )( begin + chunk_sizes[ i % chunk_sizes.size() ], end );
+
+                reader.feed( begin, chunk_end );
+
+                begin = chunk_end;
+            }
+
+            reader.finish();
+        }
+        catch( const Error_position& e )
+        {
+            error = e;
+
+            try  // the error is reported again
+            {
+                reader.finish();
+                assert( false );
+            }
+            catch( const Error_position& e2 )
+            {
+                assert_eq( e2, e );
+            }
+
+            return false;
+        }
+
+        assert( reader.is_complete() );
+
+        return true;
+    }
+
+    // the text is split in every place, and randomly, the result must be the same as read()'s
+
+    template< class Value_type >
+    void check_incremental_reader( const typename Incremental_reader< Value_type >::Text_type& s )
+    {
+        Value_type expected_value;
+        Error_position expected_error;
+
+        const bool expected_success = read( s, expected_value, expected_error );
+
+        vector< vector< int > > splits;
+
+        splits.push_back( vector< int >( 1, static_cast< int >( s.size() ) + 1 ) );
+        splits.push_back( vector< int >( 1, 1 ) );
+        splits.push_back( list_of( 2 )( 3 )( 1 )( 7 ) );
+
+        for( int i = 1; i < static_cast< int >( s.size() ); ++i )
+        {
+            splits.push_back( list_of( i )( static_cast< int >( s.size() ) ) );
+        }
+
+        for( int i = 0; i < 10; ++i )
+        {
+            vector< int > sizes;
+
+            for( int j = 0; j < 20; ++j ) sizes.push_back( 1 + rand() % 5 );
+
+            splits.push_back( sizes );
+        }
+
+        for( vector< vector< int > >::const_iterator i = splits.begin(); i != splits.end(); ++i )
+        {
+            Value_type value;
+            Error_position error;
+
+            assert_eq( read_incrementally( s, *i, value, error ), expected_success );
+
+            if( expected_success )
+            {
+                assert_eq( value, expected_value );
+            }
+            else
+            {
+#ifndef JSON_SPIRIT_USE_SPIRIT_GRAMMER  // the grammar reports some errors elsewhere
+                assert_eq( error, expected_error );
+#endif
+            }
+        }
+    }
+
+    template< class Value_type >
+    void check_incremental_error( const string& s, const Error_position& expected_error )
+    {
+        Value_type value;
+        Error_position error;
+
+        assert_eq( read_incrementally( s, vector< int >( 1, 1 ), value, error ), false );
+        assert_eq( error, expected_error );
+    }
+
+    void test_incremental_reader()
+    {
+        vector< string > docs;
+
+        docs.push_back( "[ 1, 2 ]" );
+        docs.push_back( "{ \"a\" : [ { \"b\" : [ 1, \"x\\ty\\\"\\\\\" ] } ], \"c\" : null, \"d\" : {}, \"e\" : [] }" );
+        docs.push_back( " \r\n\t[ true, false, -1.5e3, 18446744073709551615, \"\\x7F\\u00e9\" ]\n" );
+        docs.push_back( "123" );
+        docs.push_back( "-0.25E-2 " );
+        docs.push_back( "\"abc\"" );
+        docs.push_back( "[ 01, 1., .1, +1 ]" );
+        docs.push_back( "[{}, [[]], { } ]" );
+        docs.push_back( "" );
+        docs.push_back( "  " );
+        docs.push_back( "[ 1, ]" );
+        docs.push_back( "[ 1 2 ]" );
+        docs.push_back( "[ 1e ]" );
+        docs.push_back( "[ 1-2 ]" );
+        docs.push_back( "[ x ]" );
+        docs.push_back( "[ tru ]" );
+        docs.push_back( "[ truex ]" );
+        docs.push_back( "[ \"abc ]" );
+        docs.push_back( "[ \"\\x80\" ]" );
+        docs.push_back( "[ \"\\x8\" ]" );
+        docs.push_back( "[ \"\\xZ\" ]" );
+        docs.push_back( "{ \"a\" 1 }" );
+        docs.push_back( "{ \"a\" : }" );
+        docs.push_back( "{ \"a\" : 1, }" );
+        docs.push_back( "{ , }" );
+        docs.push_back( "{ \"a\" : 1 ]" );
+        docs.push_back( "{ \"a\" : [ 1, { \"b\" : tru } ] }" );
+        docs.push_back( "{ \"a\"" );
+        docs.push_back( "{ \"a\" :" );
+        docs.push_back( "[ 1" );
+        docs.push_back( "[ 1," );
+        docs.push_back( "[\n\t\"a\",\r\n\t\"b\",\r\t\"c\",\n\t*\n]" );
+        docs.push_back( "-" );
+        docs.push_back( "nul" );
+        docs.push_back( "]" );
+
+        for( vector< string >::const_iterator i = docs.begin(); i != docs.end(); ++i )
+        {
+            check_incremental_reader< Value  >( *i );
+            check_incremental_reader< mValue >( *i );
+        }
+
+#ifndef BOOST_NO_STD_WSTRING
+        check_incremental_reader< wValue >( L"{ \"a\" : [ 1, \"\\u00e9\" ] }" );
+        check_incremental_reader< wValue >( L"[ 1, " );
+#endif
+
+        // only white space may follow the value
+
+        check_incremental_error< Value >( "[ 1 ] 2", Error_position( 1, 7, "extra text after the value" ) );
+        check_incremental_error< Value >( "12x", Error_position( 1, 3, "extra text after the value" ) );
+        check_incremental_error< Value >( "1.5.2", Error_position( 1, 4, "extra text after the value" ) );
+
+        // a number at the end of the text is only read by finish()
+
+        Value value;
+        Incremental_reader< Value > reader( value );
+
+        reader.feed( "[ 1 ] " );
+        assert( reader.is_complete() );
+        assert_eq( value, Value( Array( 1, 1 ) ) );
+
+        Incremental_reader< Value > number_reader( value );
+
+        number_reader.feed( "12" );
+        number_reader.feed( "3" );
+        assert( !number_reader.is_complete() );
+        number_reader.finish();
+        assert( number_reader.is_complete() );
+        assert_eq( value, Value( 123 ) );
+    }
+
+#ifdef JSON_SPIRIT_TEST_THREADS
+
+    // reads a document in every way, the result describes the values read and any errors
+
+    string read_every_way( const string& s )
+    {
+        string result;
+
+        Value value;
+        Error_position error;
+
+        if( read( s, value, error ) ) result += write( value );
+        else result += error.reason_ + " " + lexical_cast< string >( error.line_ ) + " " + lexical_cast< string >( error.column_ );
+
+        mValue m_value;
+        if( read( s, m_value ) ) result += write( m_value );
+
+        cValue c_value;
+        if( read( s, c_value ) ) result += write( c_value );
+
+        vValue v_value;
+        if( read( s, v_value ) ) result += write( v_value );
+
+        {
+            Arena arena;
+            Arena::Scope scope( arena );
+
+            aValue a_value;
+            if( read( s, a_value ) ) result += write( a_value );
+        }
+
+        istringstream is( s );
+
+        Value stream_value;
+        if( read( is, stream_value ) ) result += write( stream_value );
+
+        internal_::Structural_index index;  // the classification read_in_parallel splits documents with
+
+        if( index.build( s.data(), s.data() + s.size() ) )
+        {
+            boost::uint64_t sum = 0;
+
+            for( size_t i = 0; i < index.offsets().size(); ++i ) sum += index.offsets()[i];
+
+            result += lexical_cast< string >( index.offsets().size() ) + " " + lexical_cast< string >( sum );
+        }
+
+        try
+        {
+            read_or_throw( s, value );
+        }
+        catch( const Error_position& e )
+        {
+            result += e.reason_;
+        }
+
+        return result;
+    }
+
+    // reads the documents repeatedly, stopping if a result differs
+
+    void read_concurrently( const vector< string >* docs, const vector< string >* expected_results, 
+                            int nb_iterations, int* nb_failures )
+    {
+        for( int i = 0; i < nb_iterations; ++i )
+        {
+            for( vector< string >::size_type j = 0; j < docs->size(); ++j )
+            {
+                if( read_every_way( ( *docs )[j] ) != ( *expected_results )[j] )
+                {
+                    ++*nb_failures;
+                    return;
+                }
+            }
+        }
+    }
+
+    void test_concurrent_reads()
+    {
+        string large_doc( "[" );
+
+        while( large_doc.size() < 100000 )  // many times the size of the block string scans and the stream's chunks
+        {
+            large_doc += "{\"name\\t\" : \"va\\\"lue\\\\\", \"x\" : [ 1, 2.5e-3, \"\\u00e9\\ud834\\udd1e\", true, null ] },\n";
+        }
+
+        vector< string > docs;
+
+        docs.push_back( large_doc + "{}]" );
+        docs.push_back( large_doc + "{]" );
+        docs.push_back( "{ \"a\" : [ 1, -2, 3.5, 18446744073709551615, -9223372036854775808, 1e308 ], \"b\" : { \"c\" : \"\\\\\\/\\b\\f\\n\\r\\t\" } }" );
+        docs.push_back( "[ [ [ [ [ [ [ [ [ [ \"deep\" ] ] ] ] ] ] ] ] ] ]" );
+        docs.push_back( "{ \"a\" 1 }" );
+        docs.push_back( "\"\\u12\"" );
+        docs.push_back( "0.1234567890123456789" );
+
+        vector< string > expected_results;
+
+        for( vector< string >::size_type i = 0; i < docs.size(); ++i )
+        {
+            expected_results.push_back( read_every_way( docs[i] ) );
+        }
+
+        const unsigned int nb_threads = ( std::max )( 4u, std::thread::hardware_concurrency() );
+
+        vector< std::thread > threads;
+        vector< int > nb_failures( nb_threads, 0 );  // one count for each thread
+
+        for( unsigned int i = 0; i < nb_threads; ++i )
+        {
+            threads.push_back( std::thread( read_concurrently, &docs, &expected_results, 10, &nb_failures[i] ) );
+        }
+
+        for( unsigned int i = 0; i < nb_threads; ++i )
+        {
+            threads[i].join();
+
+            assert_eq( nb_failures[i], 0 );
+        }
+    }
+
+#endif
+}
+
+//#include <fstream>
+
+void json_spirit::test_reader()
+{
+    Test_runner< Config  >().run_tests();
+    Test_runner< mConfig >().run_tests();
+    Test_runner< cConfig >().run_tests();
+    Test_runner< hConfig >().run_tests();
+    Test_runner< fConfig >().run_tests();
+
+#ifndef BOOST_NO_STD_WSTRING
+    Test_runner< wConfig  >().run_tests();
+    Test_runner< wmConfig >().run_tests();
+    Test_runner< wcConfig >().run_tests();
+    Test_runner< whConfig >().run_tests();
+    Test_runner< wfConfig >().run_tests();
+    test_wide_esc_u();
+#endif
+
+    test_extended_ascii();
+    test_structural_index();
+    test_long_strings();
+    test_large_document();
+    test_stream_is_left_after_value();
+    test_read_file();
+    test_read_lines();
+    test_read_in_parallel();
+    test_read_events();
+    test_cursor();
+    test_arena();
+    test_string_views();
+    test_interned_names();
+    test_hash_objects();
+    test_flat_objects();
+    test_writing_copies_nothing();
+    test_reader_class();
+    test_incremental_reader();
+
+#ifdef JSON_SPIRIT_TEST_THREADS
+    test_concurrent_reads();
+#endif
 
 #ifndef _DEBUG
     //ifstream ifs( "test.txt" );
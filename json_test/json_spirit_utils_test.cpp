@@ -8,6 +8,7 @@
 #include "utils_test.h"
 
 #include <boost/assign/list_of.hpp>
+#include <boost/lexical_cast.hpp>
 
 using namespace json_spirit;
 using namespace std;
@@ -123,10 +124,93 @@ namespace
             check_find( obj_3, "abc", 3 );
         }
 
+        void check_find_in_index( const Obj_t& obj, const char* name, const Value_type& expected_result )
+        {
+            const Object_index< Obj_t > index( obj );
+
+            assert_eq( find_value( index, to_str( name ) ), expected_result );
+            assert_eq( find_value( index, to_str( name ) ), expected_result );  // now the index has been built
+        }
+
+        void test_object_index()
+        {
+            check_find_in_index( Obj_t(), "not there", Value_type::null );
+
+            const Obj_t obj_1 = list_of( Pair_type( to_str( "a" ), 1 ) )( Pair_type( to_str( "ab" ), 2 ) )( Pair_type( to_str( "a" ), 3 ) );
+
+            check_find_in_index( obj_1, "not there", Value_type::null );
+            check_find_in_index( obj_1, "", Value_type::null );
+            check_find_in_index( obj_1, "a", 1 );  // the first of the duplicates, as find_value() on the object
+            check_find_in_index( obj_1, "ab", 2 );
+
+            Obj_t obj_2;
+
+            for( int i = 0; i < 100; ++i )
+            {
+                obj_2.push_back( Pair_type( to_str( "name_" ) + to_str( boost::lexical_cast< std::string >( i ).c_str() ), i ) );
+            }
+
+            Object_index< Obj_t > index( obj_2 );
+
+            for( int i = 0; i < 100; ++i )
+            {
+                const String_type name = to_str( "name_" ) + to_str( boost::lexical_cast< std::string >( i ).c_str() );
+
+                assert_eq( find_value( index, name ), Value_type( i ) );
+                assert_eq( *index.find( name.c_str() ), Value_type( i ) );
+            }
+
+            // the index notices members being added and removed
+
+            obj_2.push_back( Pair_type( to_str( "added" ), 100 ) );
+
+            assert_eq( find_value( index, to_str( "added" ) ), Value_type( 100 ) );
+
+            obj_2.erase( obj_2.begin(), obj_2.begin() + 50 );
+
+            assert( index.find( to_str( "name_0" ) ) == 0 );
+            assert_eq( find_value( index, to_str( "name_50" ) ), Value_type( 50 ) );
+
+            // and changes that keep the object's size and storage
+
+            obj_2.reserve( obj_2.size() + 10 );
+            obj_2.push_back( Pair_type( to_str( "added_2" ), 102 ) );
+
+            assert_eq( find_value( index, to_str( "added_2" ) ), Value_type( 102 ) );
+
+            obj_2.pop_back();
+            obj_2.push_back( Pair_type( to_str( "replaced" ), 101 ) );
+
+            assert( index.find( to_str( "added_2" ) ) == 0 );
+            assert_eq( find_value( index, to_str( "replaced" ) ), Value_type( 101 ) );
+
+            obj_2[0].name_ = to_str( "renamed" );
+
+            assert_eq( find_value( index, to_str( "renamed" ) ), Value_type( 50 ) );
+            assert( index.find( to_str( "name_50" ) ) == 0 );
+
+            std::swap( obj_2[1], obj_2[2] );
+
+            assert_eq( find_value( index, to_str( "name_51" ) ), Value_type( 51 ) );
+            assert_eq( find_value( index, to_str( "name_52" ) ), Value_type( 52 ) );
+
+            obj_2.erase( obj_2.begin() + 3 );
+            obj_2.push_back( Pair_type( to_str( "name_53" ), 153 ) );
+
+            assert_eq( find_value( index, to_str( "name_53" ) ), Value_type( 153 ) );
+
+            // a value changed in place is found
+
+            obj_2[1].value_ = to_str( "changed" );
+
+            assert_eq( find_value( index, to_str( "name_52" ) ), Value_type( to_str( "changed" ) ) );
+        }
+
         void run_tests()
         {
             test_obj_to_map();
             test_find();
+            test_object_index();
         }
     };
 }
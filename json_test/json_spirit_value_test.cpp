@@ -5,11 +5,16 @@
 
 #include "json_spirit_value_test.h"
 #include "json_spirit_value.h"
+#include "json_spirit_compact_value.h"
+#include "json_spirit_hash_object.h"
+#include "json_spirit_flat_object.h"
 #include "utils_test.h"
+#include "allocation_count.h"
 #include <limits.h>
 
 #include <boost/assign/list_of.hpp>
 #include <boost/integer_traits.hpp>
+#include <boost/lexical_cast.hpp>
 
 using namespace json_spirit;
 using namespace std;
@@ -288,6 +293,145 @@ namespace
         assert_eq( obj.find( "name 2" )->second.get_str(), "two" );
     }
 
+    void test_hash_object()
+    {
+        hObject obj;
+
+        assert_eq( obj.empty(), true );
+        assert( obj.find( "x" ) == obj.end() );
+
+        obj[ "name 2" ] = "two";
+        obj[ "name 1" ] = 1;
+        obj[ "name 2" ] = 2;  // replaces the value, keeping the member's place
+
+        assert_eq( obj.size(), 2u );
+        assert_eq( obj.begin()->first, "name 2" );
+        assert_eq( obj.begin()->second.get_int(), 2 );
+        assert_eq( obj.find( "name 1" )->second.get_int(), 1 );
+        assert_eq( obj.count( "name 3" ), 0u );
+
+        assert_eq( obj.insert( hObject::value_type( "name 1", 3 ) ).second, false );
+        assert_eq( obj[ "name 1" ].get_int(), 1 );
+
+        // members keep their order as the table grows and after one is erased
+
+        for( int i = 0; i < 1000; ++i )
+        {
+            assert_eq( obj.insert( hObject::value_type( lexical_cast< string >( i ), i ) ).second, true );
+        }
+
+        assert_eq( obj.erase( "name 1" ), 1u );
+        assert_eq( obj.erase( "name 1" ), 0u );
+        assert_eq( obj.size(), 1001u );
+
+        hObject::const_iterator i = obj.begin();
+
+        assert_eq( i->first, "name 2" );
+
+        for( int j = 0; j < 1000; ++j )
+        {
+            ++i;
+
+            assert_eq( i->first, lexical_cast< string >( j ) );
+            assert_eq( obj.find( i->first ), i );
+        }
+
+        // objects with the same members are equal whatever their order
+
+        hObject obj_1;  obj_1[ "a" ] = 1; obj_1[ "b" ] = 2;
+        hObject obj_2;  obj_2[ "b" ] = 2; obj_2[ "a" ] = 1;
+        hObject obj_3;  obj_3[ "b" ] = 2; obj_3[ "c" ] = 1;
+
+        assert_eq( hValue( obj_1 ), hValue( obj_2 ) );
+        assert_neq( hValue( obj_1 ), hValue( obj_3 ) );
+
+        hValue v1( obj_1 );
+        const hValue v2( v1 );
+
+        v1.get_obj()[ "a" ] = 3;
+
+        assert_eq( v2.get_obj().find( "a" )->second.get_int(), 1 );
+
+        obj_3.reserve( 100 );
+        obj_3.clear();
+
+        assert_eq( obj_3.size(), 0u );
+        assert( obj_3.find( "b" ) == obj_3.end() );
+    }
+
+    void test_flat_object()
+    {
+        fObject obj;
+
+        assert_eq( obj.is_sorted(), true );
+        assert( obj.find( "x" ) == obj.end() );
+
+        obj[ "name 2" ] = "two";
+        obj[ "name 1" ] = 1;
+        obj[ "name 2" ] = 2;
+
+        assert_eq( obj.size(), 2u );
+        assert_eq( obj.begin()->first, "name 1" );  // members are in the order of their names
+        assert_eq( obj.find( "name 2" )->second.get_int(), 2 );
+        assert_eq( obj.count( "name 3" ), 0u );
+        assert_eq( obj.insert( fObject::value_type( "name 0", 0 ) ).second, true );
+        assert_eq( obj.insert( fObject::value_type( "name 1", 3 ) ).second, false );
+        assert_eq( obj.begin()->first, "name 0" );
+        assert_eq( obj.is_sorted(), true );
+
+        // appended members are found before the object is sorted, the last with a name winning
+
+        obj.append( fObject::value_type( "name 4", 4 ) );
+        obj.append( fObject::value_type( "name 3", 3 ) );
+        obj.append( fObject::value_type( "name 1", 10 ) );
+
+        assert_eq( obj.is_sorted(), false );
+        assert_eq( obj.size(), 6u );
+        assert_eq( obj.find( "name 1" )->second.get_int(), 10 );
+        assert_eq( obj.find( "name 4" )->second.get_int(), 4 );
+        assert_eq( obj[ "name 5" ].is_null(), true );
+
+        obj.sort();
+
+        assert_eq( obj.is_sorted(), true );
+        assert_eq( obj.size(), 6u );
+
+        int j = 0;
+
+        for( fObject::const_iterator i = obj.begin(); i != obj.end(); ++i, ++j )
+        {
+            assert_eq( i->first, "name " + lexical_cast< string >( j ) );
+            assert_eq( obj.find( i->first ), i );
+        }
+
+        assert_eq( obj.find( "name 1" )->second.get_int(), 10 );
+        assert_eq( obj.erase( "name 1" ), 1u );
+        assert_eq( obj.erase( "name 1" ), 0u );
+        assert_eq( obj.size(), 5u );
+        assert_eq( obj.is_sorted(), true );
+
+        // objects with the same members are equal whether sorted or not
+
+        fObject obj_1; obj_1[ "a" ] = 1; obj_1[ "b" ] = 2;
+        fObject obj_2; obj_2.append( fObject::value_type( "b", 2 ) ); obj_2.append( fObject::value_type( "a", 1 ) );
+        fObject obj_3; obj_3[ "b" ] = 2; obj_3[ "c" ] = 1;
+
+        assert_eq( fValue( obj_1 ), fValue( obj_2 ) );
+        assert_neq( fValue( obj_1 ), fValue( obj_3 ) );
+
+        fValue v1( obj_1 );
+        const fValue v2( v1 );
+
+        v1.get_obj()[ "a" ] = 3;
+
+        assert_eq( v2.get_obj().find( "a" )->second.get_int(), 1 );
+
+        obj_3.clear();
+
+        assert_eq( obj_3.size(), 0u );
+        assert_eq( obj_3.is_sorted(), true );
+    }
+
     template< typename Int >
     void check_an_int_is_a_real( Int i, bool expected_result )
     {
@@ -315,6 +459,233 @@ namespace
         check_an_int_is_a_real( max_int64,  9223372036854775800.0 );
         check_an_int_is_a_real( max_uint64, 18446744073709552000.0 );
     }
+
+    template< typename T >
+    void check_compact_value( const T& t, Value_type expected_type, bool expected_is_uint64 = false )
+    {
+        const cValue v1( t );
+        const cValue v2( v1 );
+        cValue v3;
+        v3 = v2;
+
+        assert_eq( v1.type(), expected_type );
+        assert_eq( v1.is_uint64(), expected_is_uint64 );
+        assert_eq( v1, v2 );
+        assert_eq( v1, v3 );
+        assert_eq( v3.get_value< T >(), t );
+        assert_eq( v3.is_uint64(), expected_is_uint64 );
+    }
+
+    void test_compact_value()
+    {
+        assert( sizeof( cValue ) <= 16 );
+
+        check_compact_value( 1,              int_type );
+        check_compact_value( max_int64,      int_type );
+        check_compact_value( max_uint64,     int_type, true );
+        check_compact_value( 1.5,            real_type );
+        check_compact_value( true,           bool_type );
+        check_compact_value( false,          bool_type );
+        check_compact_value( string( "test" ), str_type );
+        check_compact_value( string(),         str_type );
+        check_compact_value( string( 100, 'x' ) + '\0' + "y", str_type );
+
+        cArray a; a.push_back( 1 ); a.push_back( "2" );
+
+        check_compact_value( a, array_type );
+
+        cObject obj; obj.push_back( cPair( "name1", a ) );
+
+        check_compact_value( obj, obj_type );
+
+        assert_eq( cValue().is_null(), true );
+        assert_eq( cValue(), cValue::null );
+        assert_eq( cValue( max_uint64 ).get_real(), 18446744073709552000.0 );
+        assert_eq( cValue( -1 ).get_uint64(), max_uint64 );
+        assert_neq( cValue( 1 ), cValue( 1.0 ) );
+        assert_neq( cValue( 1 ), cValue( true ) );
+        assert_neq( cValue( "1" ), cValue( "2" ) );
+        assert_neq( cValue( "1" ), cValue( "12" ) );
+        assert_eq( cValue( "abc" ).get_str(), string( "abc" ) );
+        assert_eq( cValue( "abc" ).get_str().size(), 3u );
+
+        const cValue s0( "abc" );
+        const string& s0_str = s0.get_str();
+
+        assert_eq( s0_str.find( 'c' ), 2u );
+
+        cValue s1( "first" );
+        cValue s2( string( 50, 's' ) );
+
+        s1 = s2;
+
+        assert_eq( s1.get_str(), string( 50, 's' ) );
+        assert( s1.get_str().data() != s2.get_str().data() );
+
+        s2 = cValue( 2 );
+
+        assert_eq( s1.get_str(), string( 50, 's' ) );
+        assert_eq( s2.get_int(), 2 );
+
+        cValue v1( a );
+        const cValue v2( v1 );
+
+        v1.get_array()[0] = 3;
+
+        assert_eq( v1.get_array()[0].get_int(), 3 );
+        assert_eq( v2.get_array()[0].get_int(), 1 );
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        cValue v3( std::move( v1 ) );
+
+        assert_eq( v1.is_null(), true );
+        assert_eq( v3.get_array()[0].get_int(), 3 );
+
+        v1 = std::move( v3 );
+
+        assert_eq( v3.is_null(), true );
+        assert_eq( v1.get_array()[0].get_int(), 3 );
+#endif
+    }
+
+    void test_compact_vector()
+    {
+        assert( sizeof( cArray ) == sizeof( void* ) );
+        assert( sizeof( cObject ) == sizeof( void* ) );
+
+        cArray a;
+
+        assert_eq( a.empty(), true );
+        assert_eq( a.capacity(), 0u );
+        assert( a.begin() == a.end() );
+
+        a.push_back( "element 0" );
+
+        for( int i = 1; i < 20; ++i )
+        {
+            a.push_back( a[0] );  // the element added may be one that is moved when the array grows
+        }
+
+        assert_eq( a.size(), 20u );
+        assert_eq( a.back(), cValue( "element 0" ) );
+
+        for( int i = 0; i < 20; ++i )
+        {
+            a[i] = i;
+        }
+
+        const cArray b( a );
+
+        assert_eq( a, b );
+        assert( &a[0] != &b[0] );
+
+        assert_eq( a.erase( a.begin() + 5 )->get_int(), 6 );
+        assert_eq( a.erase( a.begin(), a.begin() + 2 )->get_int(), 2 );
+        assert_eq( a.size(), 17u );
+        assert_eq( a.front().get_int(), 2 );
+        assert_eq( a.back().get_int(), 19 );
+        assert_neq( a, b );
+
+        const cArray c( b.begin() + 2, b.end() );
+
+        assert_eq( c.size(), 18u );
+        assert_eq( c.front().get_int(), 2 );
+
+        a.reserve( 100 );
+
+        assert_eq( a.capacity(), 100u );
+        assert_eq( a.size(), 17u );
+        assert_eq( a.back().get_int(), 19 );
+
+        a.pop_back();
+        a.clear();
+
+        assert_eq( a.empty(), true );
+        assert_eq( a.capacity(), 100u );
+
+        cArray d( b );
+
+        a.swap( d );
+
+        assert_eq( a, b );
+        assert_eq( d.empty(), true );
+
+        const cValue e( b );
+
+        const unsigned long start = nb_allocations();
+
+        const cValue f( e );  // the array and its elements are a single allocation
+
+        assert_eq( nb_allocations() - start, 1u );
+        assert_eq( f, e );
+
+        cObject obj;
+
+        Config_compact< string >::add( obj, "name", cValue( 1 ) );
+
+        assert_eq( obj.size(), 1u );
+        assert_eq( obj[0].name_, string( "name" ) );
+        assert_eq( obj[0].value_.get_int(), 1 );
+    }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+
+    // moving a value hands over its array or object, leaving the moved value null
+
+    template< class Value_type >
+    void check_moving()
+    {
+        typedef typename Value_type::Array Array_type;
+
+        Array_type a;
+
+        a.push_back( Value_type( 1 ) );
+        a.push_back( Value_type( "2" ) );
+
+        Value_type v1( a );
+
+        const Value_type* first = &v1.get_array()[0];
+
+        Value_type v2( std::move( v1 ) );
+
+        assert_eq( v1.is_null(), true );
+        assert_eq( v1, Value_type() );
+        assert_eq( v2, Value_type( a ) );
+        assert_eq( &v2.get_array()[0], first );
+
+        v1 = std::move( v2 );
+
+        assert_eq( v2.is_null(), true );
+        assert_eq( &v1.get_array()[0], first );
+
+        Value_type& v3 = v1;
+
+        v1 = std::move( v3 );
+
+        assert_eq( &v1.get_array()[0], first );
+
+        Value_type v4( "str" );
+
+        v1 = std::move( v4 );
+
+        assert_eq( v4.is_null(), true );
+        assert_eq( v1.get_str(), "str" );
+
+#ifndef BOOST_NO_CXX11_NOEXCEPT
+        assert( noexcept( Value_type( std::move( v1 ) ) ) );
+        assert( noexcept( v1 = std::move( v2 ) ) );
+#endif
+    }
+
+    void test_moving()
+    {
+        check_moving< Value  >();
+        check_moving< mValue >();
+        check_moving< hValue >();
+        check_moving< fValue >();
+    }
+
+#endif
 }
 
 void json_spirit::test_value()
@@ -356,6 +727,13 @@ void json_spirit::test_value()
     test_get_value();
     test_copying();
     test_obj_map_implemention();
+    test_hash_object();
+    test_flat_object();
     test_is_uint64();
     test_an_int_is_a_real();
+    test_compact_value();
+    test_compact_vector();
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    test_moving();
+#endif
 }
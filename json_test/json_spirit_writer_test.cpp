@@ -8,6 +8,7 @@
 #include "json_spirit_value.h" 
 #include "utils_test.h"
 
+#include <cstdlib>
 #include <sstream>
 #include <boost/integer_traits.hpp>
 
@@ -46,9 +47,9 @@ namespace
             add_value( obj, c_name, to_str( c_value ) );
         }
 
-        void check_eq( const Value_type& value, const char* expected_result )
+        void check_eq( const Value_type& value, const char* expected_result, unsigned int options = 0 )
         {
-            assert_eq( write( value ), to_str( expected_result ) );
+            assert_eq( write( value, options ), to_str( expected_result ) );
         }
 
         void check_eq_pretty( const Value_type& value, const char* expected_result )
@@ -215,10 +216,111 @@ namespace
             add_value( obj, "name_3", -1234567890.123456 );
             add_value( obj, "name_4", -1.2e-126 );
      
+            check_eq( obj, "{\"name_1\":1.0,"
+                           "\"name_2\":1.234567890123456e-108,"
+                           "\"name_3\":-1234567890.123456,"
+                           "\"name_4\":-1.2e-126}" );
+
             check_eq( obj, "{\"name_1\":1.000000000000000,"
                            "\"name_2\":1.234567890123456e-108,"
                            "\"name_3\":-1234567890.123456,"
-                           "\"name_4\":-1.200000000000000e-126}" );
+                           "\"name_4\":-1.200000000000000e-126}", legacy_real_format );
+        }
+
+        void check_real( double d, const char* expected_result )
+        {
+            check_eq( d, expected_result );
+
+            // the shortest text is read back as the same value
+
+            const String_type s = write( Value_type( d ) );
+
+            assert_eq( strtod( string( s.begin(), s.end() ).c_str(), 0 ), d );
+        }
+
+        // the number of significant digits in the text of a real
+
+        int nb_significant_digits( const String_type& s )
+        {
+            string digits;
+
+            for( typename String_type::const_iterator i = s.begin(); i != s.end() && *i != 'e'; ++i )
+            {
+                if( *i >= '0' && *i <= '9' ) digits += static_cast< char >( *i );
+            }
+
+            const string::size_type first = digits.find_first_not_of( '0' );
+
+            if( first == string::npos ) return 1;
+
+            return static_cast< int >( digits.find_last_not_of( '0' ) - first + 1 );
+        }
+
+        // the fewest significant digits printf needs for d to read back as d
+
+        int shortest_precision( double d )
+        {
+            for( int precision = 1; ; ++precision )
+            {
+                char text[ 32 ];
+
+                sprintf( text, "%.*g", precision, d );
+
+                if( strtod( text, 0 ) == d ) return precision;
+            }
+        }
+
+        void check_shortest_length( double d )
+        {
+            const String_type s = write( Value_type( d ) );
+
+            assert_eq( strtod( string( s.begin(), s.end() ).c_str(), 0 ), d );
+            assert_eq( nb_significant_digits( s ), shortest_precision( d ) );
+        }
+
+        void test_shortest_reals()
+        {
+            check_real( 0.0,       "0.0" );
+            check_real( -0.0,      "-0.0" );
+            check_real( 1.0,       "1.0" );
+            check_real( -2.5,      "-2.5" );
+            check_real( 0.1,       "0.1" );
+            check_real( 0.3,       "0.3" );
+            check_real( 1e-6,      "0.000001" );
+            check_real( 1e-7,      "1e-7" );
+            check_real( 1.5e-7,    "1.5e-7" );
+            check_real( 1e21,      "1e21" );
+            check_real( 1e20,      "100000000000000000000.0" );
+            check_real( 123456.75, "123456.75" );
+            check_real( 5e-324,    "5e-324" );
+            check_real( 1.7976931348623157e308,  "1.7976931348623157e308" );
+            check_real( 2.2250738585072014e-308, "2.2250738585072014e-308" );
+            check_real( 9007199254740993.0,      "9007199254740992.0" );
+            check_real( 0.1 + 0.2,               "0.30000000000000004" );
+
+            // decimals close to the edge of the interval that reads back as the double
+
+            check_real( 0.68256,   "0.68256" );
+            check_real( 0.10218,   "0.10218" );
+            check_real( 0.032093,  "0.032093" );
+            check_real( 0.0035416, "0.0035416" );
+            check_real( 25177795440463832.0, "25177795440463830.0" );
+
+            // short decimals, as in telemetry, and large values
+
+            for( int i = 0; i < 20000; ++i )
+            {
+                const long n = ( static_cast< long >( rand() ) * ( RAND_MAX + 1L ) + rand() ) % 10000000;
+
+                const int k = rand() % 16;
+
+                double power_of_ten = 1;
+
+                for( int j = 0; j < k; ++j ) power_of_ten *= 10;  // exact for k < 23
+
+                check_shortest_length( n / power_of_ten );
+                check_shortest_length( n * power_of_ten * 1e9 );
+            }
         }
 
         void test_objs_with_null_pairs()
@@ -276,11 +378,11 @@ namespace
             arr.push_back( false );
             arr.push_back( Value_type() );
 
-            check_eq       ( arr, "[\"value_1\",123,123.4560000000000,true,false,null]" );
+            check_eq       ( arr, "[\"value_1\",123,123.456,true,false,null]" );
             check_eq_pretty( arr, "[\n"
                                   "    \"value_1\",\n"
                                   "    123,\n"
-                                  "    123.4560000000000,\n" 
+                                  "    123.456,\n" 
                                   "    true,\n"
                                   "    false,\n"
                                   "    null\n"
@@ -475,10 +577,47 @@ namespace
             assert_eq( os.str(), to_str( "[1,2]" ) );
         }
 
+        void test_to_string()
+        {
+            Array_type arr;
+
+            arr.push_back( 1 );
+            arr.push_back( 2 );
+
+            String_type s( to_str( "abc" ) );
+
+            write( arr, s );
+
+            assert_eq( s, to_str( "abc[1,2]" ) );
+
+            write_formatted( arr, s );
+
+            assert_eq( s, to_str( "abc[1,2][\n    1,\n    2\n]" ) );
+        }
+
+        void test_large_value_to_stream()
+        {
+            // larger than the block in which stream output is collected
+
+            Array_type arr;
+
+            for( int i = 0; i < 2000; ++i )
+            {
+                arr.push_back( to_str( "a \"string\" value" ) );
+                arr.push_back( -i );
+            }
+
+            basic_ostringstream< Char_type > os;
+
+            write_formatted( arr, os );
+
+            assert_eq( os.str(), write_formatted( arr ) );
+        }
+
         void test_values()
         {
             check_eq( 123, "123" );
-            check_eq( 1.234, "1.234000000000000" );
+            check_eq( 1.234, "1.234" );
             check_eq( to_str( "abc" ), "\"abc\"" );
             check_eq( false, "false" );
             check_eq( Value_type::null, "null" );
@@ -515,6 +654,7 @@ namespace
             test_objs_with_bool_pairs();
             test_objs_with_int_pairs();
             test_objs_with_real_pairs();
+            test_shortest_reals();
             test_objs_with_null_pairs();
             test_empty_array();
             test_array_with_one_member();
@@ -527,6 +667,8 @@ namespace
             test_obj_and_arrays();
             test_escape_chars();
             test_to_stream();
+            test_to_string();
+            test_large_value_to_stream();
             test_values();
             test_uint64();
         }
@@ -568,10 +710,16 @@ void json_spirit::test_writer()
 {
     Test_runner< Config  >().run_tests();
     Test_runner< mConfig >().run_tests();
+    Test_runner< cConfig >().run_tests();
+    Test_runner< hConfig >().run_tests();
+    Test_runner< fConfig >().run_tests();
 
 #ifndef BOOST_NO_STD_WSTRING
     Test_runner< wConfig  >().run_tests();
     Test_runner< wmConfig >().run_tests();
+    Test_runner< wcConfig >().run_tests();
+    Test_runner< whConfig >().run_tests();
+    Test_runner< wfConfig >().run_tests();
     test_wide_esc_u();
 #endif
 
@@ -15,7 +15,7 @@
 using namespace std;
 using namespace json_spirit;
 
-int main()
+int main( int argc, char* argv[] )
 {
     test_value();
     test_writer();
@@ -23,6 +23,9 @@ int main()
     test_utils();
 
     cout << "all tests passed" << endl << endl;
+
+    if( argc > 1 && string( argv[1] ) == "--no-wait" ) return 0;  // as run by ctest
+
     cout << "press any key to continue";
 
     string s;